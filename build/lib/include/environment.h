@@ -0,0 +1,31 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#ifndef __ENVIRONMENT_H__
+#define __ENVIRONMENT_H__
+
+#include "./types.h"
+#include "./string.h"
+#include "./variabletable.h"
+
+typedef struct environment_s {
+    variabletable_t** data;
+    size_t size;        // Scopes above count are NULL or empty tables kept for reuse
+    size_t count;
+    size_t local_mode_limit;
+} environment_t;
+
+environment_t* environment_create();
+environment_t* environment_create_with(variabletable_t* global); // global is owned by the environment
+void environment_write(environment_t* env, string_t* name, object_t* obj);
+object_t* environment_get(environment_t* env, string_t* name);
+object_t** environment_get_var(environment_t* env, string_t* name);
+void environment_make(environment_t* env, string_t* name);
+void environment_del(environment_t* env, string_t* name);
+void environment_add_scope(environment_t* env);
+void environment_remove_scope(environment_t* env);
+void environment_free(environment_t* env);
+id_t environment_id(environment_t* env);
+bool_t environment_equ(environment_t* e1, environment_t* e2);
+void environment_set_local_mode(environment_t* env, size_t local_mode_limit);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,27 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#ifndef __FUNCTION_H__
+#define __FUNCTION_H__
+
+#include "./types.h"
+#include "./operation.h"
+#include "./bool.h"
+
+// The parameter and function trees are shared with the program, function_create only references them
+typedef struct function_s {
+    operation_t* parameter;
+    operation_t* function;
+    string_t** par_names;   // Parameter names if all parameters are plain variables, otherwise NULL
+    size_t num_par;
+    object_t* self;         // Value bound to func_self, created on the first call
+    bool_t self_owned;      // False for the function inside self, it must not free its owner
+} function_t;
+
+function_t* function_create(operation_t* par, operation_t* func);
+void* function_exec(function_t* func, object_t** par, environment_t* env);
+object_t** function_result(function_t* func, object_t** par, environment_t* env);
+void function_free(function_t* func);
+id_t function_id(function_t* func);
+bool_t function_equ(function_t* f1, function_t* f2);
+
+#endif
@@ -0,0 +1,30 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#ifndef __LANGALLOCATOR_H__
+#define __LANGALLOCATOR_H__
+
+#include <stdlib.h>
+
+// Blocks up to LANGALLOCATOR_MAX_SMALL bytes are taken from per thread size-class free lists,
+// bigger blocks are passed on to malloc. Memory from _alloc must be resized with _realloc and released with _free.
+#define LANGALLOCATOR_GRANULE 8
+#define LANGALLOCATOR_MAX_SMALL 256
+#define LANGALLOCATOR_SLAB_SIZE (1 << 16)
+
+typedef struct langallocator_stats_s {
+    size_t allocations;
+    size_t frees;
+    size_t slabs;
+    size_t bytes;       // Size of the blocks currently handed out
+} langallocator_stats_t;
+
+void* langallocator_alloc(size_t size);
+void* langallocator_realloc(void* ptr, size_t size);
+void langallocator_free(void* ptr);
+langallocator_stats_t langallocator_stats(); // Counts for the calling thread
+
+#define _free langallocator_free
+#define _alloc langallocator_alloc
+#define _realloc langallocator_realloc
+
+#endif
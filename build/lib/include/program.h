@@ -0,0 +1,19 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#ifndef __PROGRAM_H__
+#define __PROGRAM_H__
+
+#include "./tokenlist.h"
+#include "./operation.h"
+#include "./environment.h"
+
+typedef    operation_t program_t;
+
+program_t* parse_program(tokenlist_t* tokens);
+void program_set_optimize(bool_t optimize); // Whether tokenize_and_parse_program runs the optimizer, on by default
+program_t* tokenize_and_parse_program(const char* src);
+void program_free(program_t* program);
+void program_exec(program_t* program, environment_t* env);
+object_t** program_result(program_t* program, environment_t* env);
+
+#endif
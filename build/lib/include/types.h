@@ -0,0 +1,21 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#ifndef __TYPES_H__
+#define __TYPES_H__
+
+#include <stdlib.h>
+
+//#define size_t unsigned int
+//#define NULL (void*)0
+
+typedef unsigned int id_t;
+typedef int pos_t;
+typedef unsigned int upos_t;
+
+typedef unsigned char uchar_t;
+
+
+typedef struct object_s object_t;
+typedef void (*object_visitor_t)(object_t* obj);
+
+#endif
\ No newline at end of file
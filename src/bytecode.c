@@ -0,0 +1,553 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#include "./bytecode.h"
+#include "./jit.h"
+#include "./langallocator.h"
+
+static void bytecode_compile_exec_into(bytecode_t* code, operation_t* op);
+static void bytecode_compile_result_into(bytecode_t* code, operation_t* op);
+static void bytecode_compile_var_into(bytecode_t* code, operation_t* op);
+
+static bytecode_t* bytecode_create() {
+    bytecode_t* ret = (bytecode_t*)_alloc(sizeof(bytecode_t));
+
+    ret->size = 16;
+    ret->length = 0;
+    ret->instructions = (instruction_t*)_alloc(sizeof(instruction_t)*ret->size);
+
+    return ret;
+}
+
+static size_t bytecode_emit(bytecode_t* code, opcode_t opcode, long arg, operation_t* op) {
+    if(code->length == code->size) {
+        code->size *= 2;
+        code->instructions = (instruction_t*)_realloc(code->instructions, sizeof(instruction_t)*code->size);
+    }
+    code->instructions[code->length].opcode = opcode;
+    code->instructions[code->length].arg = arg;
+    code->instructions[code->length].jump = 0;
+    code->instructions[code->length].jump_alt = 0;
+    code->instructions[code->length].op = op;
+    code->instructions[code->length].cache_env = NULL;
+    code->instructions[code->length].cache_generation = 0;
+    code->instructions[code->length].cache_limit = 0;
+    code->instructions[code->length].cache_loc = NULL;
+    code->instructions[code->length].deopts = 0;
+    return code->length++;
+}
+
+static size_t bytecode_emit_jump(bytecode_t* code, size_t target) {
+    size_t ret = bytecode_emit(code, OPCODE_JUMP, 0, NULL);
+    code->instructions[ret].jump = target;
+    return ret;
+}
+
+size_t bytecode_count_operations(operation_t* op) {
+    size_t ret = 0;
+    while(op->data.operations[ret] != NULL) ret++;
+    return ret;
+}
+
+bool_t bytecode_is_self_add(operation_t* op) {
+    operation_t* var = op->data.operations[0];
+    operation_t* add = op->data.operations[1];
+    return var != NULL && add != NULL && var->type == OPERATION_TYPE_VAR && add->type == OPERATION_TYPE_ADD
+        && bytecode_count_operations(add) == 2 && add->data.operations[0]->type == OPERATION_TYPE_VAR
+        && string_equ(var->data.str, add->data.operations[0]->data.str);
+}
+
+static void bytecode_compile_self_add(bytecode_t* code, operation_t* op, long result) {
+    operation_t* add = op->data.operations[1];
+    bytecode_compile_result_into(code, add->data.operations[0]);
+    size_t check_left = bytecode_emit(code, OPCODE_CHECK, 0, add);
+    bytecode_compile_result_into(code, add->data.operations[1]);
+    size_t check_right = bytecode_emit(code, OPCODE_CHECK, 1, add);
+    size_t inplace = bytecode_emit(code, OPCODE_ADD_INPLACE, 0, add->data.operations[0]);
+    bytecode_emit(code, OPCODE_ARITHMETIC, 2, add);
+    code->instructions[check_left].jump = code->length;
+    code->instructions[check_right].jump = code->length;
+    code->instructions[inplace].jump = code->length;
+    bytecode_compile_var_into(code, op->data.operations[0]);
+    bytecode_emit(code, OPCODE_ASSIGN, result, op);
+}
+
+static void bytecode_compile_cond(bytecode_t* code, operation_t* op, cond_msg_t msg, size_t* cond) {
+    bytecode_compile_result_into(code, op);
+    *cond = bytecode_emit(code, OPCODE_COND, msg, NULL);
+}
+
+static void bytecode_compile_exec_into(bytecode_t* code, operation_t* op) {
+    if(op == NULL) {
+        bytecode_emit(code, OPCODE_STATUS, 0, NULL);
+        return;
+    }
+    switch(op->type) {
+        case OPERATION_TYPE_NOOP:
+        case OPERATION_TYPE_NOOP_BRAC:
+        case OPERATION_TYPE_NOOP_EMP_REC:
+        case OPERATION_TYPE_NOOP_O_LIST_DEADEND:
+        case OPERATION_TYPE_NOOP_PROC_DEADEND:
+        case OPERATION_TYPE_NOOP_PLUS:
+        case OPERATION_TYPE_NOOP_EMP_CUR:
+        case OPERATION_TYPE_NONE:
+        case OPERATION_TYPE_NUM:
+        case OPERATION_TYPE_STR:
+        case OPERATION_TYPE_BOOL:
+        case OPERATION_TYPE_FUNCTION:
+        case OPERATION_TYPE_MACRO:
+            bytecode_emit(code, OPCODE_STATUS, 0, NULL);
+            break;
+        case OPERATION_TYPE_VAR:
+            bytecode_emit(code, OPCODE_VAR_EXEC, 0, op);
+            break;
+        case OPERATION_TYPE_ASSIGN:
+            if(bytecode_is_self_add(op)) {
+                bytecode_compile_self_add(code, op, 0);
+                break;
+            }
+            bytecode_compile_result_into(code, op->data.operations[1]);
+            bytecode_compile_var_into(code, op->data.operations[0]);
+            bytecode_emit(code, OPCODE_ASSIGN, 0, op);
+            break;
+        case OPERATION_TYPE_PROC:
+        case OPERATION_TYPE_PROC_IMP: {
+            size_t num_op = bytecode_count_operations(op);
+            size_t* jumps = (size_t*)_alloc(sizeof(size_t)*num_op);
+            for(int i = 0; i < num_op; i++) {
+                bytecode_compile_exec_into(code, op->data.operations[i]);
+                if(i+1 < num_op)
+                    jumps[i] = bytecode_emit(code, OPCODE_JUMP_ERROR, 0, NULL);
+            }
+            for(int i = 0; i+1 < num_op; i++)
+                code->instructions[jumps[i]].jump = code->length;
+            _free(jumps);
+        } break;
+        case OPERATION_TYPE_EXEC:
+            bytecode_compile_result_into(code, op->data.operations[0]);
+            bytecode_compile_result_into(code, op->data.operations[1]);
+            bytecode_emit(code, OPCODE_CALL, 0, op);
+            break;
+        case OPERATION_TYPE_WRITE:
+            bytecode_compile_result_into(code, op->data.operations[0]);
+            bytecode_emit(code, OPCODE_WRITE, 0, op);
+            break;
+        case OPERATION_TYPE_SCOPE:
+            bytecode_emit(code, OPCODE_SCOPE_ENTER, 0, op);
+            bytecode_compile_exec_into(code, op->data.operations[0]);
+            bytecode_emit(code, OPCODE_SCOPE_EXIT, 0, op);
+            break;
+        case OPERATION_TYPE_LOCAL:
+        case OPERATION_TYPE_GLOBAL:
+            bytecode_emit(code, op->type == OPERATION_TYPE_LOCAL ? OPCODE_LIMIT_LOCAL : OPCODE_LIMIT_GLOBAL, 0, op);
+            bytecode_compile_exec_into(code, op->data.operations[0]);
+            bytecode_emit(code, OPCODE_LIMIT_RESTORE, 0, op);
+            break;
+        case OPERATION_TYPE_IF: {
+            size_t cond;
+            bytecode_compile_cond(code, op->data.operations[0], COND_MSG_IF, &cond);
+            bytecode_compile_exec_into(code, op->data.operations[1]);
+            size_t jump = bytecode_emit(code, OPCODE_JUMP, 0, NULL);
+            size_t skip = bytecode_emit(code, OPCODE_STATUS, 0, NULL);
+            code->instructions[cond].jump_alt = skip;
+            code->instructions[cond].jump = code->length;
+            code->instructions[jump].jump = code->length;
+        } break;
+        case OPERATION_TYPE_IFELSE: {
+            size_t cond;
+            bytecode_compile_cond(code, op->data.operations[0], COND_MSG_IFELSE, &cond);
+            bytecode_compile_exec_into(code, op->data.operations[1]);
+            size_t jump = bytecode_emit(code, OPCODE_JUMP, 0, NULL);
+            code->instructions[cond].jump_alt = code->length;
+            bytecode_compile_exec_into(code, op->data.operations[2]);
+            code->instructions[cond].jump = code->length;
+            code->instructions[jump].jump = code->length;
+        } break;
+        case OPERATION_TYPE_WHILE: {
+            size_t jit = jit_is_enabled() ? bytecode_emit(code, OPCODE_JIT_LOOP, 0, op) : 0;
+            size_t start = code->length;
+            size_t cond;
+            bytecode_compile_cond(code, op->data.operations[0], COND_MSG_WHILE, &cond);
+            bytecode_compile_exec_into(code, op->data.operations[1]);
+            size_t error = bytecode_emit(code, OPCODE_JUMP_ERROR, 0, NULL);
+            bytecode_emit_jump(code, start);
+            size_t skip = bytecode_emit(code, OPCODE_STATUS, 0, NULL);
+            code->instructions[cond].jump_alt = skip;
+            code->instructions[cond].jump = code->length;
+            code->instructions[error].jump = code->length;
+            if(code->instructions[jit].opcode == OPCODE_JIT_LOOP)
+                code->instructions[jit].jump = code->length;
+        } break;
+        case OPERATION_TYPE_FOR: {
+            bytecode_compile_exec_into(code, op->data.operations[0]);
+            bytecode_emit(code, OPCODE_POP, 0, NULL);
+            size_t jit = jit_is_enabled() ? bytecode_emit(code, OPCODE_JIT_LOOP, 0, op) : 0;
+            size_t start = code->length;
+            size_t cond;
+            bytecode_compile_cond(code, op->data.operations[1], COND_MSG_FOR_LOWER, &cond);
+            bytecode_compile_exec_into(code, op->data.operations[3]);
+            size_t error_body = bytecode_emit(code, OPCODE_JUMP_ERROR, 0, NULL);
+            bytecode_compile_exec_into(code, op->data.operations[2]);
+            size_t error_step = bytecode_emit(code, OPCODE_JUMP_ERROR, 0, NULL);
+            bytecode_emit_jump(code, start);
+            size_t skip = bytecode_emit(code, OPCODE_STATUS, 0, NULL);
+            code->instructions[cond].jump_alt = skip;
+            code->instructions[cond].jump = code->length;
+            code->instructions[error_body].jump = code->length;
+            code->instructions[error_step].jump = code->length;
+            if(code->instructions[jit].opcode == OPCODE_JIT_LOOP)
+                code->instructions[jit].jump = code->length;
+        } break;
+        case OPERATION_TYPE_FOR_IN: {
+            bytecode_compile_var_into(code, op->data.operations[0]);
+            bytecode_compile_result_into(code, op->data.operations[1]);
+            size_t init = bytecode_emit(code, OPCODE_FORIN_INIT, 0, op);
+            size_t next = bytecode_emit(code, OPCODE_FORIN_NEXT, 0, op);
+            bytecode_compile_exec_into(code, op->data.operations[2]);
+            size_t check = bytecode_emit(code, OPCODE_FORIN_CHECK, 0, op);
+            code->instructions[check].jump = next;
+            size_t done = bytecode_emit(code, OPCODE_FORIN_END, 0, op);
+            code->instructions[next].jump = done;
+            bytecode_emit(code, OPCODE_STATUS, 0, NULL);
+            code->instructions[init].jump = code->length;
+            code->instructions[check].jump_alt = code->length;
+        } break;
+        default:
+            bytecode_emit(code, OPCODE_TREE_EXEC, 0, op);
+            break;
+    }
+}
+
+static void bytecode_compile_loop_result(bytecode_t* code, operation_t* op) {
+    operation_t* cond_op = op->data.operations[op->type == OPERATION_TYPE_FOR ? 1 : 0];
+    operation_t* body_op = op->data.operations[op->type == OPERATION_TYPE_FOR ? 3 : 1];
+    operation_t* step_op = op->type == OPERATION_TYPE_FOR ? op->data.operations[2] : NULL;
+    cond_msg_t msg = op->type == OPERATION_TYPE_FOR ? COND_MSG_FOR : COND_MSG_WHILE;
+    cond_msg_t msg_exec = op->type == OPERATION_TYPE_FOR ? COND_MSG_FOR_LOWER : COND_MSG_WHILE;
+    size_t init = 0;
+    size_t cond_first, cond_again, cond_exec;
+    size_t step = 0;
+    size_t step_exec = 0;
+
+    if(op->type == OPERATION_TYPE_FOR) {
+        bytecode_compile_exec_into(code, op->data.operations[0]);
+        init = bytecode_emit(code, OPCODE_JUMP_ERROR, 0, NULL);
+    }
+    bytecode_emit(code, OPCODE_ACC_BEGIN, 0, NULL);
+    bytecode_compile_cond(code, cond_op, msg, &cond_first);
+    size_t start = code->length;
+    bytecode_compile_result_into(code, body_op);
+    size_t append = bytecode_emit(code, OPCODE_ACC_APPEND, 0, NULL);
+    if(step_op != NULL) {
+        bytecode_compile_exec_into(code, step_op);
+        step = bytecode_emit(code, OPCODE_JUMP_ERROR, 0, NULL);
+    }
+    bytecode_compile_cond(code, cond_op, msg, &cond_again);
+    bytecode_emit_jump(code, start);
+
+    size_t done = bytecode_emit(code, OPCODE_ACC_END, 0, NULL);
+    size_t done_end = bytecode_emit(code, OPCODE_JUMP, 0, NULL);
+    size_t drop = bytecode_emit(code, OPCODE_ACC_DROP, 0, NULL);
+    size_t drop_end = bytecode_emit(code, OPCODE_JUMP, 0, NULL);
+
+    // After the first iteration without a result the condition is still considered true
+    size_t start_exec = code->length;
+    bytecode_compile_exec_into(code, body_op);
+    size_t body_exec = bytecode_emit(code, OPCODE_JUMP_ERROR, 0, NULL);
+    if(step_op != NULL) {
+        bytecode_compile_exec_into(code, step_op);
+        step_exec = bytecode_emit(code, OPCODE_JUMP_ERROR, 0, NULL);
+    }
+    bytecode_compile_cond(code, cond_op, msg_exec, &cond_exec);
+    bytecode_emit_jump(code, start_exec);
+    size_t skip = bytecode_emit(code, OPCODE_STATUS, VM_STATUS_NULL, NULL);
+    code->instructions[cond_exec].jump_alt = skip;
+    size_t end = code->length;
+
+    if(op->type == OPERATION_TYPE_FOR)
+        code->instructions[init].jump = end;
+    code->instructions[cond_first].jump = drop;
+    code->instructions[cond_first].jump_alt = done;
+    code->instructions[append].jump = drop;
+    code->instructions[append].jump_alt = start_exec;
+    if(step_op != NULL) {
+        code->instructions[step].jump = drop;
+        code->instructions[step_exec].jump = end;
+    }
+    code->instructions[cond_again].jump = drop;
+    code->instructions[cond_again].jump_alt = done;
+    code->instructions[done_end].jump = end;
+    code->instructions[drop_end].jump = end;
+    code->instructions[body_exec].jump = end;
+    code->instructions[cond_exec].jump = end;
+}
+
+static void bytecode_compile_for_in_result(bytecode_t* code, operation_t* op) {
+    bytecode_emit(code, OPCODE_ACC_BEGIN, 0, NULL);
+    bytecode_compile_var_into(code, op->data.operations[0]);
+    bytecode_compile_result_into(code, op->data.operations[1]);
+    size_t init = bytecode_emit(code, OPCODE_FORIN_INIT, 1, op);
+    size_t next = bytecode_emit(code, OPCODE_FORIN_NEXT, 0, op);
+    bytecode_compile_result_into(code, op->data.operations[2]);
+    size_t append = bytecode_emit(code, OPCODE_ACC_APPEND, 0, NULL);
+    bytecode_emit_jump(code, next);
+
+    size_t done = bytecode_emit(code, OPCODE_FORIN_END, 0, op);
+    bytecode_emit(code, OPCODE_ACC_END, 0, NULL);
+    size_t done_end = bytecode_emit(code, OPCODE_JUMP, 0, NULL);
+    size_t body_error = bytecode_emit(code, OPCODE_FORIN_DROP, 0, op);
+    size_t drop = bytecode_emit(code, OPCODE_ACC_DROP, 0, NULL);
+    size_t drop_end = bytecode_emit(code, OPCODE_JUMP, 0, NULL);
+
+    // After the first iteration without a result the body is only executed
+    size_t next_exec = bytecode_emit(code, OPCODE_FORIN_NEXT, 0, op);
+    bytecode_compile_exec_into(code, op->data.operations[2]);
+    size_t check = bytecode_emit(code, OPCODE_FORIN_CHECK, 0, op);
+    size_t done_exec = bytecode_emit(code, OPCODE_FORIN_END, 0, op);
+    bytecode_emit(code, OPCODE_STATUS, VM_STATUS_NULL, NULL);
+    size_t end = code->length;
+
+    code->instructions[init].jump = drop;
+    code->instructions[next].jump = done;
+    code->instructions[append].jump = body_error;
+    code->instructions[append].jump_alt = next_exec;
+    code->instructions[done_end].jump = end;
+    code->instructions[drop_end].jump = end;
+    code->instructions[next_exec].jump = done_exec;
+    code->instructions[check].jump = next_exec;
+    code->instructions[check].jump_alt = end;
+}
+
+static void bytecode_compile_result_into(bytecode_t* code, operation_t* op) {
+    if(op == NULL) {
+        bytecode_emit(code, OPCODE_STATUS, VM_STATUS_NULL, NULL);
+        return;
+    }
+    switch(op->type) {
+        case OPERATION_TYPE_NOOP:
+        case OPERATION_TYPE_NOOP_BRAC:
+        case OPERATION_TYPE_NOOP_EMP_REC:
+        case OPERATION_TYPE_NOOP_O_LIST_DEADEND:
+        case OPERATION_TYPE_NOOP_PROC_DEADEND:
+        case OPERATION_TYPE_NOOP_PLUS:
+        case OPERATION_TYPE_NOOP_EMP_CUR:
+            bytecode_emit(code, OPCODE_STATUS, VM_STATUS_NULL, NULL);
+            break;
+        case OPERATION_TYPE_NONE:
+            bytecode_emit(code, OPCODE_NONE, 0, op);
+            break;
+        case OPERATION_TYPE_NUM:
+            bytecode_emit(code, op->constant != NULL ? OPCODE_CONSTANT : OPCODE_NUMBER, 0, op);
+            break;
+        case OPERATION_TYPE_STR:
+            bytecode_emit(code, op->constant != NULL ? OPCODE_CONSTANT : OPCODE_STRING, 0, op);
+            break;
+        case OPERATION_TYPE_BOOL:
+            bytecode_emit(code, OPCODE_BOOL, 0, op);
+            break;
+        case OPERATION_TYPE_FUNCTION:
+            bytecode_emit(code, OPCODE_FUNCTION, 0, op);
+            break;
+        case OPERATION_TYPE_MACRO:
+            bytecode_emit(code, OPCODE_MACRO, 0, op);
+            break;
+        case OPERATION_TYPE_VAR:
+            bytecode_emit(code, OPCODE_VAR_RESULT, 0, op);
+            break;
+        case OPERATION_TYPE_ASSIGN:
+            if(bytecode_is_self_add(op)) {
+                bytecode_compile_self_add(code, op, 1);
+                break;
+            }
+            bytecode_compile_result_into(code, op->data.operations[1]);
+            bytecode_compile_var_into(code, op->data.operations[0]);
+            bytecode_emit(code, OPCODE_ASSIGN, 1, op);
+            break;
+        case OPERATION_TYPE_PROC:
+        case OPERATION_TYPE_PROC_IMP: {
+            size_t num_op = bytecode_count_operations(op);
+            size_t* jumps = (size_t*)_alloc(sizeof(size_t)*num_op);
+            for(int i = 0; i+1 < num_op; i++) {
+                bytecode_compile_exec_into(code, op->data.operations[i]);
+                jumps[i] = bytecode_emit(code, OPCODE_JUMP_ERROR, 0, NULL);
+            }
+            bytecode_compile_result_into(code, op->data.operations[num_op-1]);
+            for(int i = 0; i+1 < num_op; i++)
+                code->instructions[jumps[i]].jump = code->length;
+            _free(jumps);
+        } break;
+        case OPERATION_TYPE_O_LIST:
+        case OPERATION_TYPE_ADD:
+        case OPERATION_TYPE_SUB:
+        case OPERATION_TYPE_MUL:
+        case OPERATION_TYPE_DIV:
+        case OPERATION_TYPE_MOD:
+        case OPERATION_TYPE_POW:
+        case OPERATION_TYPE_AND:
+        case OPERATION_TYPE_OR:
+        case OPERATION_TYPE_XOR: {
+            size_t num_op = bytecode_count_operations(op);
+            size_t* jumps = (size_t*)_alloc(sizeof(size_t)*num_op);
+            size_t* shorts = (size_t*)_alloc(sizeof(size_t)*num_op);
+            for(int i = 0; i < num_op; i++) {
+                bytecode_compile_result_into(code, op->data.operations[i]);
+                jumps[i] = bytecode_emit(code, OPCODE_CHECK, i, op);
+                shorts[i] = 0;
+                if(i+1 < num_op && (op->type == OPERATION_TYPE_AND || op->type == OPERATION_TYPE_OR))
+                    shorts[i] = bytecode_emit(code, OPCODE_SHORT_CIRCUIT, i, op);
+            }
+            if(op->type == OPERATION_TYPE_O_LIST)
+                bytecode_emit(code, OPCODE_CONCAT, num_op, op);
+            else
+                bytecode_emit(code, OPCODE_ARITHMETIC, num_op, op);
+            for(int i = 0; i < num_op; i++) {
+                code->instructions[jumps[i]].jump = code->length;
+                if(shorts[i] != 0)
+                    code->instructions[shorts[i]].jump = code->length;
+            }
+            _free(shorts);
+            _free(jumps);
+        } break;
+        case OPERATION_TYPE_NEG:
+        case OPERATION_TYPE_NOT:
+            bytecode_compile_result_into(code, op->data.operations[0]);
+            bytecode_emit(code, OPCODE_UNARY, 0, op);
+            break;
+        case OPERATION_TYPE_EQU:
+        case OPERATION_TYPE_GEQ:
+        case OPERATION_TYPE_LEQ:
+        case OPERATION_TYPE_GTR:
+        case OPERATION_TYPE_LES:
+            bytecode_compile_result_into(code, op->data.operations[0]);
+            bytecode_compile_result_into(code, op->data.operations[1]);
+            bytecode_emit(code, OPCODE_COMPARE, 0, op);
+            break;
+        case OPERATION_TYPE_INDEX:
+            bytecode_compile_result_into(code, op->data.operations[0]);
+            bytecode_compile_result_into(code, op->data.operations[1]);
+            bytecode_emit(code, OPCODE_INDEX, 0, op);
+            break;
+        case OPERATION_TYPE_LIST:
+            bytecode_compile_result_into(code, op->data.operations[0]);
+            bytecode_emit(code, OPCODE_LIST, 0, op);
+            break;
+        case OPERATION_TYPE_LIST_OPEN:
+            bytecode_compile_result_into(code, op->data.operations[0]);
+            bytecode_emit(code, OPCODE_LIST_OPEN, 0, op);
+            break;
+        case OPERATION_TYPE_EXEC:
+            bytecode_compile_result_into(code, op->data.operations[0]);
+            bytecode_compile_result_into(code, op->data.operations[1]);
+            bytecode_emit(code, OPCODE_CALL, 1, op);
+            break;
+        case OPERATION_TYPE_WRITE:
+            bytecode_compile_result_into(code, op->data.operations[0]);
+            bytecode_emit(code, OPCODE_WRITE, VM_STATUS_NULL, op);
+            break;
+        case OPERATION_TYPE_SCOPE:
+            bytecode_emit(code, OPCODE_SCOPE_ENTER, 0, op);
+            bytecode_compile_result_into(code, op->data.operations[0]);
+            bytecode_emit(code, OPCODE_SCOPE_EXIT, 0, op);
+            break;
+        case OPERATION_TYPE_LOCAL:
+        case OPERATION_TYPE_GLOBAL:
+            bytecode_emit(code, op->type == OPERATION_TYPE_LOCAL ? OPCODE_LIMIT_LOCAL : OPCODE_LIMIT_GLOBAL, 0, op);
+            bytecode_compile_result_into(code, op->data.operations[0]);
+            bytecode_emit(code, OPCODE_LIMIT_RESTORE, 0, op);
+            break;
+        case OPERATION_TYPE_IF: {
+            size_t cond;
+            bytecode_compile_cond(code, op->data.operations[0], COND_MSG_IF, &cond);
+            bytecode_compile_result_into(code, op->data.operations[1]);
+            size_t jump = bytecode_emit(code, OPCODE_JUMP, 0, NULL);
+            size_t skip = bytecode_emit(code, OPCODE_STATUS, VM_STATUS_NULL, NULL);
+            code->instructions[cond].jump_alt = skip;
+            code->instructions[cond].jump = code->length;
+            code->instructions[jump].jump = code->length;
+        } break;
+        case OPERATION_TYPE_IFELSE: {
+            size_t cond;
+            bytecode_compile_cond(code, op->data.operations[0], COND_MSG_IFELSE, &cond);
+            bytecode_compile_result_into(code, op->data.operations[1]);
+            size_t jump = bytecode_emit(code, OPCODE_JUMP, 0, NULL);
+            code->instructions[cond].jump_alt = code->length;
+            bytecode_compile_result_into(code, op->data.operations[2]);
+            code->instructions[cond].jump = code->length;
+            code->instructions[jump].jump = code->length;
+        } break;
+        case OPERATION_TYPE_WHILE:
+        case OPERATION_TYPE_FOR:
+            bytecode_compile_loop_result(code, op);
+            break;
+        case OPERATION_TYPE_FOR_IN:
+            bytecode_compile_for_in_result(code, op);
+            break;
+        default:
+            bytecode_emit(code, OPCODE_TREE_RESULT, 0, op);
+            break;
+    }
+}
+
+static void bytecode_compile_var_into(bytecode_t* code, operation_t* op) {
+    if(op == NULL) {
+        bytecode_emit(code, OPCODE_STATUS, VM_STATUS_NULL, NULL);
+        return;
+    }
+    switch(op->type) {
+        case OPERATION_TYPE_VAR:
+            bytecode_emit(code, OPCODE_VAR_LOC, 0, op);
+            break;
+        case OPERATION_TYPE_O_LIST: {
+            size_t num_op = bytecode_count_operations(op);
+            size_t* jumps = (size_t*)_alloc(sizeof(size_t)*num_op);
+            for(int i = 0; i < num_op; i++) {
+                bytecode_compile_var_into(code, op->data.operations[i]);
+                jumps[i] = bytecode_emit(code, OPCODE_CHECK_LOC, i, op);
+            }
+            bytecode_emit(code, OPCODE_CONCAT_LOC, num_op, op);
+            for(int i = 0; i < num_op; i++)
+                code->instructions[jumps[i]].jump = code->length;
+            _free(jumps);
+        } break;
+        case OPERATION_TYPE_LIST_OPEN:
+            bytecode_compile_var_into(code, op->data.operations[0]);
+            bytecode_emit(code, OPCODE_LIST_OPEN_LOC, 0, op);
+            break;
+        default:
+            bytecode_emit(code, OPCODE_TREE_VAR, 0, op);
+            break;
+    }
+}
+
+bytecode_t* bytecode_compile_exec(operation_t* op) {
+    bytecode_t* ret = bytecode_create();
+    bytecode_compile_exec_into(ret, op);
+    bytecode_emit(ret, OPCODE_RETURN, 0, NULL);
+    return ret;
+}
+
+// A call is in tail position if only jumps follow it before the return
+static void bytecode_mark_tail_calls(bytecode_t* code) {
+    for(size_t i = 0; i < code->length; i++)
+        if(code->instructions[i].opcode == OPCODE_CALL && code->instructions[i].arg != 0) {
+            size_t next = i+1;
+            while(code->instructions[next].opcode == OPCODE_JUMP)
+                next = code->instructions[next].jump;
+            if(code->instructions[next].opcode == OPCODE_RETURN)
+                code->instructions[i].opcode = OPCODE_TAIL_CALL;
+        }
+}
+
+bytecode_t* bytecode_compile_result(operation_t* op) {
+    bytecode_t* ret = bytecode_create();
+    bytecode_compile_result_into(ret, op);
+    bytecode_emit(ret, OPCODE_RETURN, 0, NULL);
+    bytecode_mark_tail_calls(ret);
+    return ret;
+}
+
+void bytecode_free(bytecode_t* code) {
+    if(code != NULL) {
+        _free(code->instructions);
+        _free(code);
+    }
+}
@@ -0,0 +1,105 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#ifndef __BYTECODE_H__
+#define __BYTECODE_H__
+
+#include "./types.h"
+#include "./operation.h"
+#include "./environment.h"
+
+// Every instruction sequence compiled for one operation leaves exactly one group on the vm stacks.
+// A group is a status (the number of values, VM_STATUS_NULL or VM_STATUS_ERROR) and its values.
+#define VM_STATUS_NULL -1
+#define VM_STATUS_ERROR -2
+
+typedef enum opcode_e {
+    OPCODE_STATUS,          // push status arg
+    OPCODE_POP,             // drop the value group on top
+    OPCODE_JUMP,            // jump to jump
+    OPCODE_JUMP_ERROR,      // jump to jump if the top status is an error, otherwise drop the top group
+    OPCODE_TREE_EXEC,       // fall back to operation_exec
+    OPCODE_TREE_RESULT,     // fall back to operation_result
+    OPCODE_TREE_VAR,        // fall back to operation_var
+    OPCODE_NONE,
+    OPCODE_NUMBER,
+    OPCODE_STRING,
+    OPCODE_BOOL,
+    OPCODE_CONSTANT,        // push the prebuilt value of literal op
+    OPCODE_FUNCTION,
+    OPCODE_MACRO,
+    OPCODE_VAR_EXEC,
+    OPCODE_VAR_RESULT,
+    OPCODE_VAR_LOC,
+    OPCODE_ASSIGN,          // arg != 0 if the value is the result
+    OPCODE_CHECK,           // check the value group of operand arg of op, jump to jump on error
+    OPCODE_CHECK_NUM,       // quickened CHECK for a scalar number, falls back to CHECK
+    OPCODE_CHECK_LOC,       // check the location group of operand arg, jump to jump on error
+    OPCODE_CONCAT,          // merge the top arg value groups
+    OPCODE_CONCAT_LOC,      // merge the top arg location groups
+    OPCODE_ARITHMETIC,      // combine the top arg checked value groups
+    OPCODE_ARITHMETIC_NUM,  // quickened ARITHMETIC for two scalar numbers, falls back to ARITHMETIC
+    OPCODE_ADD_INPLACE,     // for a = a + e, extend the value of variable op in place and jump to jump if it is not shared
+    OPCODE_SHORT_CIRCUIT,   // jump to jump with the result if the top arg+1 checked groups are scalars and decide op
+    OPCODE_UNARY,
+    OPCODE_COMPARE,
+    OPCODE_COMPARE_NUM,     // quickened COMPARE for two scalar numbers, falls back to COMPARE
+    OPCODE_INDEX,
+    OPCODE_LIST,
+    OPCODE_LIST_OPEN,
+    OPCODE_LIST_OPEN_LOC,
+    OPCODE_CALL,            // arg != 0 if the value is the result
+    OPCODE_TAIL_CALL,       // CALL with the result in tail position, a function body leaves it to its caller
+    OPCODE_WRITE,           // arg is the status pushed on success
+    OPCODE_SCOPE_ENTER,
+    OPCODE_SCOPE_EXIT,
+    OPCODE_LIMIT_LOCAL,
+    OPCODE_LIMIT_GLOBAL,
+    OPCODE_LIMIT_RESTORE,
+    OPCODE_COND,            // jump to jump_alt if false, push an error and jump to jump on error
+    OPCODE_ACC_BEGIN,
+    OPCODE_ACC_APPEND,      // jump to jump_alt if the group is NULL, jump to jump on error
+    OPCODE_ACC_END,
+    OPCODE_ACC_DROP,
+    OPCODE_FORIN_INIT,      // jump to jump on error, arg != 0 presizes the accumulator
+    OPCODE_FORIN_NEXT,      // jump to jump if there are no values left
+    OPCODE_FORIN_CHECK,     // jump to jump_alt on error, otherwise to jump
+    OPCODE_FORIN_END,
+    OPCODE_FORIN_DROP,      // cleanup the for-in state below an error
+    OPCODE_JIT_LOOP,        // run loop op in machine code and jump to jump, otherwise continue with the interpreted loop
+    OPCODE_RETURN,
+} opcode_t;
+
+typedef enum cond_msg_e {
+    COND_MSG_IF,
+    COND_MSG_IFELSE,
+    COND_MSG_WHILE,
+    COND_MSG_FOR,
+    COND_MSG_FOR_LOWER,
+} cond_msg_t;
+
+typedef struct instruction_s {
+    opcode_t opcode;
+    long arg;
+    size_t jump;
+    size_t jump_alt;
+    operation_t* op;
+    environment_t* cache_env;   // variable location cached by the vm, valid while the innermost scope and local mode match
+    size_t cache_generation;
+    size_t cache_limit;
+    object_t** cache_loc;
+    unsigned int deopts;        // number of times a quickened form of this instruction failed its guard
+} instruction_t;
+
+typedef struct bytecode_s {
+    instruction_t* instructions;
+    size_t length;
+    size_t size;
+} bytecode_t;
+
+size_t bytecode_count_operations(operation_t* op); // Number of operands of an operation with a NULL terminated operand list
+bool_t bytecode_is_self_add(operation_t* op); // Matches a = a + e, where the value of a can be extended in place if nothing else references it
+bytecode_t* bytecode_compile_exec(operation_t* op);
+bytecode_t* bytecode_compile_result(operation_t* op);
+void bytecode_free(bytecode_t* code);
+
+#endif
@@ -1,140 +1,224 @@
 // Copyright (c) 2018-2019 Roland Bernard
 
-#include <math.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "./dictionary.h"
 #include "./langallocator.h"
 #include "./prime.h"
 #include "./object.h"
 
-void dictionary_extend(dictionary_t* dic) {
-    if(dic != NULL)
-        dictionary_resize(dic, dic->size * 2);
+#define CONTROL_EMPTY 0x80
+#define CONTROL_DELETED 0xfe
+
+#define NOT_FOUND (~(size_t)0)
+
+// Bit i is set if control byte i of the group is value
+static unsigned int dictionary_match(uchar_t* control, uchar_t value) {
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128((__m128i*)control);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)value)));
+#else
+    unsigned int ret = 0;
+    for(int i = 0; i < DICTIONARY_GROUP_SIZE; i++)
+        if(control[i] == value)
+            ret |= 1 << i;
+    return ret;
+#endif
 }
 
-void dictionary_shrink(dictionary_t* dic) {
-    if(dic != NULL)
-        dictionary_resize(dic, dic->size / 2);
+// Bit i is set if slot i of the group is empty or deleted
+static unsigned int dictionary_match_free(uchar_t* control) {
+#ifdef __SSE2__
+    return _mm_movemask_epi8(_mm_loadu_si128((__m128i*)control));
+#else
+    unsigned int ret = 0;
+    for(int i = 0; i < DICTIONARY_GROUP_SIZE; i++)
+        if(control[i] & 0x80)
+            ret |= 1 << i;
+    return ret;
+#endif
 }
 
-void dictionary_check_size(dictionary_t* dic) {
-    if(dic != NULL) {
-        if(dic->count * 10 / dic->size >= 7)
-            dictionary_extend(dic);
-        else if(dic->count * 10 / dic->size == 0 && dic->count > 1)
-            dictionary_shrink(dic);
-    }
+static size_t dictionary_slots_for(size_t size) {
+    size_t ret = DICTIONARY_GROUP_SIZE;
+    while(ret - ret / 8 <= size)
+        ret *= 2;
+    return ret;
 }
 
-// TODO: Improve collision handling (Double hashing)
-upos_t dictionary_find_existing(dictionary_t* dic, object_t* key) {
-    if(dic != NULL) {
-        upos_t index = object_id(key) % dic->size;
+static void dictionary_alloc_slots(dictionary_t* dic, size_t size) {
+    dic->size = size;
+    dic->growth_left = size - size / 8 - dic->count;
+    dic->control = (uchar_t*)_alloc(sizeof(uchar_t)*size);
+    memset(dic->control, CONTROL_EMPTY, sizeof(uchar_t)*size);
+    dic->slots = (unsigned int*)_alloc(sizeof(unsigned int)*size);
+}
 
-        while(dic->data[index] != NULL && (dic->data[index] == (void*)1 || !object_equ(key, dic->data[index]->key)))
-            index = (index + 1) % dic->size;
+pair_t* dictionary_entry(dictionary_t* dic, size_t index) {
+    size_t block = (sizeof(unsigned long)*8 - 1) - __builtin_clzl(index / DICTIONARY_FIRST_BLOCK + 1);
+    return dic->blocks[block] + (index - DICTIONARY_FIRST_BLOCK * ((1UL << block) - 1));
+}
+
+static size_t dictionary_new_entry(dictionary_t* dic) {
+    if(dic->num_free > 0)
+        return dic->free_entries[--dic->num_free];
 
-        return index;
-    } else 
-        return ~0;
+    if(dic->used == DICTIONARY_FIRST_BLOCK * ((1UL << dic->num_blocks) - 1)) {
+        dic->blocks = (pair_t**)_realloc(dic->blocks, sizeof(pair_t*)*(dic->num_blocks + 1));
+        dic->blocks[dic->num_blocks] = (pair_t*)_alloc(sizeof(pair_t)*(DICTIONARY_FIRST_BLOCK << dic->num_blocks));
+        dic->num_blocks++;
+    }
+    return dic->used++;
 }
 
-upos_t dictionary_find_new(dictionary_t* dic, object_t* key) {
-    if(dic != NULL) {
-        upos_t index = object_id(key) % dic->size;
+static size_t dictionary_find(dictionary_t* dic, object_t* key, id_t hash) {
+    size_t mask = dic->size / DICTIONARY_GROUP_SIZE - 1;
+    size_t group = (hash >> 7) & mask;
+    uchar_t tag = hash & 0x7f;
 
-        while(dic->data[index] != NULL && dic->data[index] != (void*)1 && !object_equ(key, dic->data[index]->key))
-            index = (index + 1) % dic->size;
+    for(size_t step = 1;; step++) {
+        uchar_t* control = dic->control + group * DICTIONARY_GROUP_SIZE;
+        unsigned int match = dictionary_match(control, tag);
+        while(match != 0) {
+            size_t slot = group * DICTIONARY_GROUP_SIZE + __builtin_ctz(match);
+            if(object_equ(key, dictionary_entry(dic, dic->slots[slot])->key))
+                return slot;
+            match &= match - 1;
+        }
+        if(dictionary_match(control, CONTROL_EMPTY) != 0)
+            return NOT_FOUND;
+        group = (group + step) & mask;
+    }
+}
 
-        return index;
-    } else 
-        return ~0;
+static size_t dictionary_find_free(dictionary_t* dic, id_t hash) {
+    size_t mask = dic->size / DICTIONARY_GROUP_SIZE - 1;
+    size_t group = (hash >> 7) & mask;
+
+    for(size_t step = 1;; step++) {
+        unsigned int match = dictionary_match_free(dic->control + group * DICTIONARY_GROUP_SIZE);
+        if(match != 0)
+            return group * DICTIONARY_GROUP_SIZE + __builtin_ctz(match);
+        group = (group + step) & mask;
+    }
 }
 
+static void dictionary_rehash(dictionary_t* dic, size_t size) {
+    _free(dic->control);
+    _free(dic->slots);
+    dictionary_alloc_slots(dic, size);
 
-dictionary_t* dictionary_create() {
-    return dictionary_create_sized(DEFAULT_START_SIZE);
+    for(size_t i = 0; i < dic->used; i++) {
+        pair_t* entry = dictionary_entry(dic, i);
+        if(entry->key != NULL) {
+            id_t hash = object_id(entry->key);
+            size_t slot = dictionary_find_free(dic, hash);
+            dic->control[slot] = hash & 0x7f;
+            dic->slots[slot] = i;
+        }
+    }
 }
 
-dictionary_t* dictionary_create_sized(size_t size) {
+// Key must not be in the dictionary yet
+static pair_t* dictionary_insert(dictionary_t* dic, object_t* key, object_t* value, id_t hash) {
+    size_t slot = dictionary_find_free(dic, hash);
+    if(dic->growth_left == 0 && dic->control[slot] == CONTROL_EMPTY) {
+        if(dic->count * 2 < dic->size - dic->size / 8)
+            dictionary_rehash(dic, dic->size);
+        else
+            dictionary_rehash(dic, dic->size * 2);
+        slot = dictionary_find_free(dic, hash);
+    }
+    if(dic->control[slot] == CONTROL_EMPTY)
+        dic->growth_left--;
+
+    size_t index = dictionary_new_entry(dic);
+    pair_t* entry = dictionary_entry(dic, index);
+    entry->key = key;
+    object_reference(key);
+    entry->value = value;
+    object_reference(value);
+
+    dic->control[slot] = hash & 0x7f;
+    dic->slots[slot] = index;
+    dic->count++;
+
+    return entry;
+}
+
+static dictionary_t* dictionary_create_slots(size_t size) {
     dictionary_t* ret = (dictionary_t*)_alloc(sizeof(dictionary_t));
-    size_t real_size = next_prime(size);
 
     ret->count = 0;
-    ret->data = (pair_t**)_alloc(sizeof(pair_t*) * real_size);
-    for(int i = 0; i < real_size; i++)
-        ret->data[i] = NULL;
-    ret->size = real_size;
+    ret->used = 0;
+    ret->blocks = NULL;
+    ret->num_blocks = 0;
+    ret->free_entries = NULL;
+    ret->num_free = 0;
+    ret->free_size = 0;
+    dictionary_alloc_slots(ret, size);
 
     return ret;
 }
 
+dictionary_t* dictionary_create() {
+    return dictionary_create_slots(DICTIONARY_START_SIZE);
+}
+
+dictionary_t* dictionary_create_sized(size_t size) {
+    return dictionary_create_slots(dictionary_slots_for(size));
+}
+
 dictionary_t* dictionary_copy(dictionary_t* dic) {
     dictionary_t* ret = NULL;
 
     if(dic != NULL) {
-        ret = (dictionary_t*)_alloc(sizeof(dictionary_t));
-        ret->data = (pair_t**)_alloc(sizeof(pair_t*) * dic->size);
-        ret->count = dic->count;
-        for(ret->size = 0; ret->size < dic->size; ret->size++)
-            ret->data[ret->size] = pair_copy(dic->data[ret->size]);
+        ret = dictionary_create_sized(dic->count);
+        for(size_t i = 0; i < dic->used; i++) {
+            pair_t* entry = dictionary_entry(dic, i);
+            if(entry->key != NULL)
+                dictionary_insert(ret, entry->key, entry->value, object_id(entry->key));
+        }
     }
 
     return ret;
 }
 
 void dictionary_resize(dictionary_t* dic, size_t size) {
-    if(dic != NULL) {
-        dictionary_t* temp_new_dic = dictionary_create_sized(size);
-        for(int i = 0; i < temp_new_dic->size; i++)
-            temp_new_dic->data[i] = NULL;
-
-        for(int i = 0; i < dic->size; i++)
-            if(dic->data[i] != NULL)
-                dictionary_put_pair(temp_new_dic, dic->data[i]);
-
-        _free(dic->data);
-        dic->data = temp_new_dic->data;
-        dic->size = temp_new_dic->size;
-        _free(temp_new_dic);
-    }
+    if(dic != NULL)
+        dictionary_rehash(dic, dictionary_slots_for(size > dic->count ? size : dic->count));
 }
 
 void dictionary_put_pair(dictionary_t* dic, pair_t* pair) {
     if(dic != NULL) {
-        upos_t index = dictionary_find_existing(dic, pair->key);
-        if(dic->data[index] != NULL) {
-            pair_free(dic->data[index]);
-            dic->data[index] = pair;
-        } else {
-            index = dictionary_find_new(dic, pair->key);
-            dic->count++;
-            dic->data[index] = pair;
-        }
+        dictionary_put(dic, pair->key, pair->value);
+        pair_free(pair);
     }
 }
 
 void dictionary_put(dictionary_t* dic, object_t* key, object_t* value) {
     if(dic != NULL) {
-        upos_t index = dictionary_find_existing(dic, key);
-        if(dic->data[index] == NULL) {
-            index = dictionary_find_new(dic, key);
-            dic->data[index] = pair_create(key, value);
-            dic->count++;
+        id_t hash = object_id(key);
+        size_t slot = dictionary_find(dic, key, hash);
+        if(slot == NOT_FOUND) {
+            dictionary_insert(dic, key, value, hash);
         } else {
-            object_dereference(dic->data[index]->value);
-            dic->data[index]->value = value;
+            pair_t* entry = dictionary_entry(dic, dic->slots[slot]);
             object_reference(value);
+            object_dereference(entry->value);
+            entry->value = value;
         }
-        dictionary_check_size(dic);
     }
 }
 
 object_t* dictionary_get(dictionary_t* dic, object_t* key) {
     if(dic != NULL) {
-        upos_t index = dictionary_find_existing(dic, key);
-        if(dic->data[index] != NULL)
-            return dic->data[index]->value;
+        size_t slot = dictionary_find(dic, key, object_id(key));
+        if(slot != NOT_FOUND)
+            return dictionary_entry(dic, dic->slots[slot])->value;
         else
             return NULL;
     }
@@ -144,16 +228,12 @@ object_t* dictionary_get(dictionary_t* dic, object_t* key) {
 
 object_t** dictionary_get_loc(dictionary_t* dic, object_t* key) {
     if(dic != NULL) {
-        upos_t index = dictionary_find_existing(dic, key);
-        if(dic->data[index] != NULL)
-            return &(dic->data[index]->value);
-        else {
-            index = dictionary_find_new(dic, key);
-            dic->data[index] = pair_create(key, object_create_none());
-            dic->count++;
-            dictionary_check_size(dic);
-            return &(dic->data[dictionary_find_existing(dic, key)]->value);
-        }
+        id_t hash = object_id(key);
+        size_t slot = dictionary_find(dic, key, hash);
+        if(slot != NOT_FOUND)
+            return &(dictionary_entry(dic, dic->slots[slot])->value);
+        else
+            return &(dictionary_insert(dic, key, object_create_none(), hash)->value);
     }
     else
         return NULL;
@@ -161,24 +241,52 @@ object_t** dictionary_get_loc(dictionary_t* dic, object_t* key) {
 
 void dictionary_del(dictionary_t* dic, object_t* key) {
     if(dic != NULL) {
-        upos_t index = dictionary_find_existing(dic, key);
-        if(dic->data[index] != NULL) {
-            pair_free(dic->data[index]);
-            dic->data[index] = (void*)1;
+        size_t slot = dictionary_find(dic, key, object_id(key));
+        if(slot != NOT_FOUND) {
+            pair_t* entry = dictionary_entry(dic, dic->slots[slot]);
+            object_dereference(entry->key);
+            object_dereference(entry->value);
+            entry->key = NULL;
+            entry->value = NULL;
+
+            if(dic->num_free == dic->free_size) {
+                dic->free_size = dic->free_size == 0 ? 8 : dic->free_size * 2;
+                dic->free_entries = (unsigned int*)_realloc(dic->free_entries, sizeof(unsigned int)*dic->free_size);
+            }
+            dic->free_entries[dic->num_free++] = dic->slots[slot];
+
+            dic->control[slot] = CONTROL_DELETED;
             dic->count--;
         }
-        dictionary_check_size(dic);
     }
 }
 
+void dictionary_visit(dictionary_t* dic, object_visitor_t visit) {
+    if(dic != NULL)
+        for(size_t i = 0; i < dic->used; i++) {
+            pair_t* entry = dictionary_entry(dic, i);
+            if(entry->key != NULL) {
+                visit(entry->key);
+                visit(entry->value);
+            }
+        }
+}
+
 void dictionary_free(dictionary_t* dic) {
     if(dic != NULL) {
-        if(dic->data != NULL) {
-            for(int i = 0; i < dic->size; i++)
-                if(dic->data[i] != NULL)
-                    pair_free(dic->data[i]);
-            _free(dic->data);
+        for(size_t i = 0; i < dic->used; i++) {
+            pair_t* entry = dictionary_entry(dic, i);
+            if(entry->key != NULL) {
+                object_dereference(entry->key);
+                object_dereference(entry->value);
+            }
         }
+        for(size_t i = 0; i < dic->num_blocks; i++)
+            _free(dic->blocks[i]);
+        _free(dic->blocks);
+        _free(dic->free_entries);
+        _free(dic->control);
+        _free(dic->slots);
         _free(dic);
     }
 }
@@ -186,22 +294,24 @@ void dictionary_free(dictionary_t* dic) {
 bool_t dictionary_equ(dictionary_t* d1, dictionary_t* d2) {
     if(d1->count != d2->count)
         return false;
-    
-    for(int i = 0; i < d1->size; i++)
-        if(d1->data[i] != NULL)
-            if(!object_equ(d1->data[i]->value, dictionary_get(d2, d1->data[i]->key)))
+
+    for(size_t i = 0; i < d1->used; i++) {
+        pair_t* entry = dictionary_entry(d1, i);
+        if(entry->key != NULL)
+            if(!object_equ(entry->value, dictionary_get(d2, entry->key)))
                 return false;
+    }
 
     return true;
 }
 
+// The entries are combined in an order independent way, because equal dictionaries may store them differently
 id_t dictionary_id(dictionary_t* dic) {
-    long hash = 0;
-    int count_hashed = 0;
-    for (int i = 0; i < dic->size; i++) 
-        if(dic->data[i] != NULL) {
-            count_hashed++;
-            hash += (long)pow(SMALL_PRIME_4, dic->count - count_hashed) * pair_id(dic->data[i]);
-        }
-    return (id_t)hash;
+    id_t hash = dic->count;
+    for(size_t i = 0; i < dic->used; i++) {
+        pair_t* entry = dictionary_entry(dic, i);
+        if(entry->key != NULL)
+            hash += hash_combine(object_id(entry->key), object_id(entry->value));
+    }
+    return hash;
 }
@@ -3,29 +3,43 @@
 #ifndef __DICTIONARY_H__
 #define __DICTIONARY_H__
 
-#define DEFAULT_START_SIZE 11
+#define DICTIONARY_GROUP_SIZE 16
+#define DICTIONARY_START_SIZE DICTIONARY_GROUP_SIZE // Slots of a new dictionary
+#define DICTIONARY_FIRST_BLOCK 16
 
 #include "./types.h"
 #include "./pair.h"
 #include "./bool.h"
 
+// Open addressing with one control byte per slot, probed a group of slots at a time.
+// The entries are stored in blocks that never move, so locations stay valid while inserting.
 typedef struct dictionary_s {
-    size_t size;
-    size_t count;
-    pair_t** data;
+    size_t size;            // Number of slots, a power of two
+    size_t count;           // Number of entries
+    size_t used;            // Number of entries handed out, including deleted ones
+    size_t growth_left;     // Number of empty slots that can be filled before rehashing
+    uchar_t* control;
+    unsigned int* slots;    // Entry index for every full slot
+    pair_t** blocks;        // Block i holds DICTIONARY_FIRST_BLOCK << i entries
+    size_t num_blocks;
+    unsigned int* free_entries;
+    size_t num_free;
+    size_t free_size;
 } dictionary_t;
 
 dictionary_t* dictionary_create();
-dictionary_t* dictionary_create_sized(size_t size); // This will use the next bigger prime.
+dictionary_t* dictionary_create_sized(size_t size); // This will use the next bigger power of two.
 dictionary_t* dictionary_copy(dictionary_t* dic);
-void dictionary_resize(dictionary_t* dic, size_t size); // This will use the next bigger prime.
+void dictionary_resize(dictionary_t* dic, size_t size); // This will use the next bigger power of two.
 object_t* dictionary_get(dictionary_t* dic, object_t* key);
 object_t** dictionary_get_loc(dictionary_t* dic, object_t* key);
-void dictionary_put_pair(dictionary_t* dic, pair_t* pair); // If this function is used the pair will be freed together with the dictionary
+void dictionary_put_pair(dictionary_t* dic, pair_t* pair); // The pair is freed after its key and value are inserted
 void dictionary_put(dictionary_t* dic, object_t* key, object_t* value); // Value and key will be dereferenced when freeing the dictionary or deleting the entry
 void dictionary_del(dictionary_t* dic, object_t* key);
+pair_t* dictionary_entry(dictionary_t* dic, size_t index); // Entries 0 to used-1, deleted entries have a NULL key. They are reused, so after a deletion this is not the insertion order.
+void dictionary_visit(dictionary_t* dic, object_visitor_t visit); // Visits the keys and values
 void dictionary_free(dictionary_t* dic);
 bool_t dictionary_equ(dictionary_t* d1, dictionary_t* d2); // Two dictionaries are equal if they have the same key-value-pairs regardless of size
 id_t dictionary_id(dictionary_t* dic);
 
-#endif
\ No newline at end of file
+#endif
@@ -7,8 +7,11 @@
 #include "./object.h"
 #include "./langallocator.h"
 
-
 environment_t* environment_create() {
+    return environment_create_with(variabletable_create());
+}
+
+environment_t* environment_create_with(variabletable_t* global) {
     environment_t* ret = (environment_t*)_alloc(sizeof(environment_t));
     
     ret->count = 1;
@@ -16,7 +19,7 @@ environment_t* environment_create() {
     ret->data = (variabletable_t**)_alloc(sizeof(variabletable_t*));
     ret->local_mode_limit = 0;
 
-    ret->data[0] = variabletable_create();
+    ret->data[0] = global;
 
     return ret;
 }
@@ -79,6 +82,8 @@ void environment_del(environment_t* env, string_t* name) {
             variabletable_del(env->data[env->count-1], name);
         } else {
             variabletable_del(env->data[i], name);
+            // Locations are only checked against the innermost scope
+            variabletable_touch(env->data[env->count-1]);
         }
     }
 }
@@ -86,14 +91,14 @@ void environment_del(environment_t* env, string_t* name) {
 void environment_add_scope(environment_t* env) {
     if(env != NULL) {
         if(env->size == env->count) {
-            variabletable_t** tmp = (variabletable_t**)_alloc(sizeof(variabletable_t*)*(env->size+1));
-            for(int i = 0; i < env->size; i++)
-                tmp[i] = env->data[i];
-            _free(env->data);
-            env->data = tmp;
-            env->size++;
+            env->data = (variabletable_t**)_realloc(env->data, sizeof(variabletable_t*)*env->size*2);
+            for(int i = env->size; i < env->size*2; i++)
+                env->data[i] = NULL;
+            env->size *= 2;
         }
-        env->data[env->count] = variabletable_create();
+        // Tables of removed scopes are kept above count and reused
+        if(env->data[env->count] == NULL)
+            env->data[env->count] = variabletable_create();
         env->count++;
     }
 }
@@ -101,7 +106,7 @@ void environment_add_scope(environment_t* env) {
 void environment_remove_scope(environment_t* env) {
     if(env != NULL) {
         if(env->count > 1) {
-            variabletable_free(env->data[env->count-1]);
+            variabletable_clear(env->data[env->count-1]);
             env->count--;
         }
     }
@@ -109,7 +114,7 @@ void environment_remove_scope(environment_t* env) {
 
 void environment_free(environment_t* env) {
     if(env != NULL) {
-        for(int i = 0; i < env->count; i++)
+        for(int i = 0; i < env->size; i++)
             variabletable_free(env->data[i]);
         _free(env->data);
         _free(env);
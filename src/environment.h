@@ -9,12 +9,13 @@
 
 typedef struct environment_s {
     variabletable_t** data;
-    size_t size;
+    size_t size;        // Scopes above count are NULL or empty tables kept for reuse
     size_t count;
     size_t local_mode_limit;
 } environment_t;
 
 environment_t* environment_create();
+environment_t* environment_create_with(variabletable_t* global); // global is owned by the environment
 void environment_write(environment_t* env, string_t* name, object_t* obj);
 object_t* environment_get(environment_t* env, string_t* name);
 object_t** environment_get_var(environment_t* env, string_t* name);
@@ -6,28 +6,130 @@
 #include "./prime.h"
 #include "./langallocator.h"
 #include "./error.h"
-
+#include "./vm.h"
+#include "./jit.h"
+
+
+static string_t* func_self_name = NULL;
+
+// Plain parameter lists can be bound directly, without evaluating the parameter tree
+static void function_plan_parameters(function_t* func) {
+    operation_t* par = func->parameter;
+    func->par_names = NULL;
+    func->num_par = 0;
+    if(par != NULL && par->type == OPERATION_TYPE_VAR) {
+        func->par_names = (string_t**)_alloc(sizeof(string_t*));
+        func->par_names[0] = par->data.str;
+        func->num_par = 1;
+    } else if(par != NULL && par->type == OPERATION_TYPE_O_LIST) {
+        size_t num_par = 0;
+        while(par->data.operations[num_par] != NULL) {
+            if(par->data.operations[num_par]->type != OPERATION_TYPE_VAR)
+                return;
+            num_par++;
+        }
+        func->par_names = (string_t**)_alloc(sizeof(string_t*)*num_par);
+        for(size_t i = 0; i < num_par; i++)
+            func->par_names[i] = par->data.operations[i]->data.str;
+        func->num_par = num_par;
+    }
+}
 
 function_t* function_create(operation_t* par, operation_t* func) {
     function_t* ret = (function_t*)_alloc(sizeof(function_t));
 
-    ret->freeable = true;
-    ret->parameter = operation_copy(par);
-    ret->function = operation_copy(func);
+    ret->parameter = par;
+    operation_reference(par);
+    ret->function = func;
+    operation_reference(func);
+    ret->self = NULL;
+    ret->self_owned = true;
+    function_plan_parameters(ret);
 
     return ret;
 }
 
-function_t* function_create_reference(operation_t* par, operation_t* func) {
-    function_t* ret = (function_t*)_alloc(sizeof(function_t));
+static object_t* function_self(function_t* func) {
+    if(func->self == NULL) {
+        function_t* self_func = function_create(func->parameter, func->function);
+        func->self = object_create_function(self_func);
+        object_reference(func->self);
+        self_func->self = func->self;
+        self_func->self_owned = false;
+    }
+    return func->self;
+}
 
-    ret->freeable = false;
-    ret->parameter = par;
-    ret->function = func;
+// Adds the call scope and binds the parameters, returns false on error
+static bool_t function_enter(function_t* func, object_t** par, environment_t* env, size_t* prev_limit) {
+    bool_t ret = true;
+
+    environment_add_scope(env);
+    *prev_limit = env->local_mode_limit;
+    environment_set_local_mode(env, env->count-1);
+
+    if(func_self_name == NULL)
+        func_self_name = string_create("func_self");
+    environment_write(env, func_self_name, function_self(func));
+
+    if(func->par_names != NULL) {
+        size_t i;
+        for(i = 0; i < func->num_par && par != NULL && par[i] != NULL; i++)
+            environment_write(env, func->par_names[i], par[i]);
+        for(size_t j = i; j < func->num_par; j++)
+            environment_make(env, func->par_names[j]);
+        if(par != NULL && par[i] != NULL) {
+            error("Runtime error: Too many arguments to function.");
+            ret = false;
+        }
+    } else {
+        object_t*** par_loc_list = operation_var(func->parameter, env);
+
+        if(par != NULL && par_loc_list != NULL) {
+            int i;
+            for(i = 0; par_loc_list[i] != NULL && par[i] != NULL; i++) {
+                if(par_loc_list[i] == OBJECT_LIST_OPENED) {
+                    object_t** obj = par_loc_list[i+1];
+                    object_dereference(*obj);
+
+                    size_t length_left = 0;
+                    while(par[i + length_left] != NULL) length_left++;
+
+                    list_t* list = list_create_null(length_left);
+                    for(int j = 0; j < length_left; j++) {
+                        list->data[j] = par[i+j];
+                        object_reference(list->data[j]);
+                    }
+                    *obj = object_create_list(list);
+                    object_reference(*obj);
+                    break;
+                } else {
+                    object_dereference(*(par_loc_list[i]));
+                    *(par_loc_list[i]) = par[i];
+                    object_reference(*(par_loc_list[i]));
+                }
+            }
+            if(par[i] != NULL && par_loc_list[i] == NULL) {
+                error("Runtime error: Too many arguments to function.");
+                ret = false;
+            }
+            _free(par_loc_list);
+        }
+        if(par != NULL && par_loc_list == NULL) {
+            error("Runtime error: Too many arguments to function.");
+            ret = false;
+        }
+    }
 
     return ret;
 }
 
+static void function_leave(environment_t* env, size_t prev_limit) {
+    environment_del(env, func_self_name);
+    environment_set_local_mode(env, prev_limit);
+    environment_remove_scope(env);
+}
+
 void* function_exec(function_t* func, object_t** par, environment_t* env) {
     void* ret = NULL;
 
@@ -36,63 +138,25 @@ void* function_exec(function_t* func, object_t** par, environment_t* env) {
         ret = RET_ERROR;
     } else
         if(func != NULL) {
-            environment_add_scope(env);
-            size_t prev_limit = env->local_mode_limit;
-            environment_set_local_mode(env, env->count-1);
-
-            string_t* func_self_name = string_create("func_self");
-            environment_write(env, func_self_name, object_create_function(function_create_reference(func->parameter, func->function)));
-
-            object_t*** par_loc_list = operation_var(func->parameter, env);
-
-            if(par != NULL && par_loc_list != NULL) {
-                int i;
-                for(i = 0; par_loc_list[i] != NULL && par[i] != NULL; i++) {
-                    if(par_loc_list[i] == OBJECT_LIST_OPENED) {
-                        object_t** obj = par_loc_list[i+1];
-                        object_dereference(*obj);
-
-                        size_t length_left = 0;
-                        while(par[i + length_left] != NULL) length_left++;
-
-                        list_t* list = list_create_null(length_left);
-                        for(int j = 0; j < length_left; j++) {
-                            list->data[j] = par[i+j];
-                            object_reference(list->data[j]);
-                        }
-                        *obj = object_create_list(list);
-                        object_reference(*obj);
-                        break;
-                    } else {
-                        object_dereference(*(par_loc_list[i]));
-                        *(par_loc_list[i]) = par[i];
-                        object_reference(*(par_loc_list[i]));
-                    }
-                }
-                if(par[i] != NULL && par_loc_list[i] == NULL) {
-                    error("Runtime error: Too many arguments to function.");
-                    ret = RET_ERROR;
-                }
-                _free(par_loc_list);
-            }
-            if(par != NULL && par_loc_list == NULL){
-                error("Runtime error: Too many arguments to function.");
+            size_t prev_limit;
+            if(!function_enter(func, par, env, &prev_limit))
                 ret = RET_ERROR;
-            } else if(ret != RET_ERROR) {
-                if(operation_exec(func->function, env) == RET_ERROR)
-                    ret = RET_ERROR;
-            }
-
-            environment_del(env, func_self_name);
-            string_free(func_self_name);
-
-            environment_set_local_mode(env, prev_limit);
-            environment_remove_scope(env);
+            else if(vm_exec(func->function, env) == RET_ERROR)
+                ret = RET_ERROR;
+            function_leave(env, prev_limit);
         }
 
     return ret;
 }
 
+static void function_release_call(object_t* func, object_t** par) {
+    if(par != NULL) {
+        for(long i = 0; par[i] != NULL; i++)
+            object_dereference(par[i]);
+        _free(par);
+    }
+    object_dereference(func);
+}
 
 object_t** function_result(function_t* func, object_t** par, environment_t* env) {
     object_t** ret = NULL;
@@ -100,71 +164,40 @@ object_t** function_result(function_t* func, object_t** par, environment_t* env)
     if(check_for_stackoverflow()) {
         error("Runtime error: Stack overflow.");
         ret = RET_ERROR;
-    } else
-        if(func != NULL) {
-            environment_add_scope(env);
-            size_t prev_limit = env->local_mode_limit;
-            environment_set_local_mode(env, env->count-1);
-
-            string_t* func_self_name = string_create("func_self");
-            environment_write(env, func_self_name, object_create_function(function_create_reference(func->parameter, func->function)));
-
-            object_t*** par_loc_list = operation_var(func->parameter, env);
-
-            if(par != NULL && par_loc_list != NULL) {
-                int i;
-                for(i = 0; par_loc_list[i] != NULL && par[i] != NULL; i++) {
-                    if(par_loc_list[i] == OBJECT_LIST_OPENED) {
-                        object_t** obj = par_loc_list[i+1];
-                        object_dereference(*obj);
-
-                        size_t length_left = 0;
-                        while(par[i + length_left] != NULL) length_left++;
-
-                        list_t* list = list_create_null(length_left);
-                        for(int j = 0; j < length_left; j++) {
-                            list->data[j] = par[i+j];
-                            object_reference(list->data[j]);
-                        }
-                        *obj = object_create_list(list);
-                        object_reference(*obj);
-                        break;
-                    } else {
-                        object_dereference(*(par_loc_list[i]));
-                        *(par_loc_list[i]) = par[i];
-                        object_reference(*(par_loc_list[i]));
-                    }
-                }
-                if(par[i] != NULL && par_loc_list[i] == NULL) {
-                    error("Runtime error: Too many arguments to function.");
+    } else {
+        // A call in tail position of the body is made here, after the frame of the body was left
+        object_t* tail_func = NULL;
+        object_t** tail_par = NULL;
+        while(func != NULL) {
+            object_t* next_func = NULL;
+            object_t** next_par = NULL;
+            if(!jit_run_function(func, par, &ret)) {
+                size_t prev_limit;
+                if(!function_enter(func, par, env, &prev_limit))
                     ret = RET_ERROR;
-                }
-                _free(par_loc_list);
-            }
-
-            if(par != NULL && par_loc_list == NULL){
-                error("Runtime error: Too many arguments to function.");
-                ret = RET_ERROR;
-            } else if(ret != RET_ERROR) {
-                ret = operation_result(func->function, env);
+                else
+                    ret = vm_result_body(func->function, env, &next_func, &next_par);
+                function_leave(env, prev_limit);
             }
-
-            environment_del(env, func_self_name);
-            string_free(func_self_name);
-
-            environment_set_local_mode(env, prev_limit);
-            environment_remove_scope(env);
+            if(tail_func != NULL)
+                function_release_call(tail_func, tail_par);
+            tail_func = next_func;
+            tail_par = next_par;
+            func = tail_func != NULL ? tail_func->data.func : NULL;
+            par = tail_par;
         }
+    }
 
     return ret;
 }
 
 void function_free(function_t* func) {
     if(func != NULL) {
-        if(func->freeable) {
-            operation_free(func->function);
-            operation_free(func->parameter);
-        }
+        operation_free(func->function);
+        operation_free(func->parameter);
+        _free(func->par_names);
+        if(func->self_owned)
+            object_dereference(func->self);
         _free(func);
     }
 }
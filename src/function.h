@@ -7,10 +7,14 @@
 #include "./operation.h"
 #include "./bool.h"
 
+// The parameter and function trees are shared with the program, function_create only references them
 typedef struct function_s {
-    bool_t freeable;
     operation_t* parameter;
     operation_t* function;
+    string_t** par_names;   // Parameter names if all parameters are plain variables, otherwise NULL
+    size_t num_par;
+    object_t* self;         // Value bound to func_self, created on the first call
+    bool_t self_owned;      // False for the function inside self, it must not free its owner
 } function_t;
 
 function_t* function_create(operation_t* par, operation_t* func);
@@ -0,0 +1,232 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#include <stdio.h>
+
+#include "./gc.h"
+#include "./object.h"
+#include "./langallocator.h"
+
+// Count given to the objects of a cycle while it is freed, so the references between them
+// can be released in any order without freeing one of them twice
+#define GC_PINNED (((size_t)1) << (sizeof(size_t)*8 - 4))
+
+typedef struct gc_stack_s {
+    object_t** data;
+    size_t count;
+    size_t size;
+} gc_stack_t;
+
+static size_t gc_threshold = GC_DEFAULT_THRESHOLD;
+static size_t gc_limit = GC_DEFAULT_THRESHOLD;
+static bool_t gc_collecting = false;
+static size_t gc_free_depth = 0;    // Number of object_free calls in progress
+static gc_stack_t gc_roots;
+static gc_stack_t gc_work;
+static gc_stack_t gc_black_work;
+static gc_stack_t gc_garbage;
+
+static object_t* gc_parent;
+static bool_t gc_skip_self;
+static object_visitor_t gc_visitor;
+
+static size_t gc_traced = 0;
+static size_t gc_num_collections = 0;
+static size_t gc_num_objects = 0;
+static size_t gc_num_bytes = 0;
+
+void gc_set_threshold(size_t threshold) {
+    gc_threshold = threshold;
+    gc_limit = threshold;
+}
+
+static void gc_push(gc_stack_t* stack, object_t* obj) {
+    if(stack->count == stack->size) {
+        stack->size = stack->size == 0 ? 64 : 2 * stack->size;
+        stack->data = (object_t**)_realloc(stack->data, sizeof(object_t*)*stack->size);
+    }
+    stack->data[stack->count] = obj;
+    stack->count++;
+}
+
+static object_t* gc_pop(gc_stack_t* stack) {
+    stack->count--;
+    return stack->data[stack->count];
+}
+
+static void gc_filter(object_t* obj) {
+    if(obj == NULL || obj == OBJECT_LIST_OPENED || !object_is_container(obj))
+        return;
+    if(obj == gc_parent && gc_skip_self) {
+        // The self member a struct is created with is not counted as a reference
+        gc_skip_self = false;
+        return;
+    }
+    gc_visitor(obj);
+}
+
+// Calls visit for the containers obj holds a counted reference to
+static void gc_visit_references(object_t* obj, object_visitor_t visit) {
+    gc_parent = obj;
+    gc_skip_self = obj->type == OBJECT_TYPE_STRUCT;
+    gc_visitor = visit;
+    object_visit_references(obj, gc_filter);
+}
+
+static void gc_mark_gray_visit(object_t* obj) {
+    obj->num_references--;
+    if(obj->gc_color != GC_COLOR_GRAY) {
+        obj->gc_color = GC_COLOR_GRAY;
+        gc_push(&gc_work, obj);
+    }
+}
+
+// Subtracts the references between the objects reachable from obj
+static void gc_mark_gray(object_t* obj) {
+    if(obj->gc_color != GC_COLOR_GRAY) {
+        obj->gc_color = GC_COLOR_GRAY;
+        gc_push(&gc_work, obj);
+        while(gc_work.count > 0) {
+            gc_traced++;
+            gc_visit_references(gc_pop(&gc_work), gc_mark_gray_visit);
+        }
+    }
+}
+
+static void gc_scan_black_visit(object_t* obj) {
+    obj->num_references++;
+    if(obj->gc_color != GC_COLOR_BLACK) {
+        obj->gc_color = GC_COLOR_BLACK;
+        gc_push(&gc_black_work, obj);
+    }
+}
+
+// Restores the references of everything reachable from obj, which is still in use
+static void gc_scan_black(object_t* obj) {
+    obj->gc_color = GC_COLOR_BLACK;
+    gc_push(&gc_black_work, obj);
+    while(gc_black_work.count > 0)
+        gc_visit_references(gc_pop(&gc_black_work), gc_scan_black_visit);
+}
+
+static void gc_scan_visit(object_t* obj) {
+    gc_push(&gc_work, obj);
+}
+
+static void gc_scan(object_t* obj) {
+    gc_push(&gc_work, obj);
+    while(gc_work.count > 0) {
+        obj = gc_pop(&gc_work);
+        if(obj->gc_color == GC_COLOR_GRAY) {
+            if(obj->num_references > 0)
+                gc_scan_black(obj);
+            else {
+                obj->gc_color = GC_COLOR_WHITE;
+                gc_visit_references(obj, gc_scan_visit);
+            }
+        }
+    }
+}
+
+static void gc_collect_white_visit(object_t* obj) {
+    if(obj->gc_color == GC_COLOR_WHITE && !obj->gc_buffered) {
+        obj->gc_color = GC_COLOR_BLACK;
+        gc_push(&gc_garbage, obj);
+        gc_push(&gc_work, obj);
+    }
+}
+
+static void gc_collect_white(object_t* obj) {
+    gc_collect_white_visit(obj);
+    while(gc_work.count > 0)
+        gc_visit_references(gc_pop(&gc_work), gc_collect_white_visit);
+}
+
+static void gc_restore_visit(object_t* obj) {
+    // Releasing the garbage will take back its references to objects that stay
+    if(obj->num_references < GC_PINNED / 2)
+        obj->num_references++;
+}
+
+static void gc_free_garbage() {
+    size_t bytes = langallocator_stats().bytes;
+    // The objects are marked as buffered, so they are not buffered again while being released
+    for(size_t i = 0; i < gc_garbage.count; i++) {
+        gc_garbage.data[i]->num_references = GC_PINNED;
+        gc_garbage.data[i]->gc_buffered = true;
+    }
+    for(size_t i = 0; i < gc_garbage.count; i++)
+        gc_visit_references(gc_garbage.data[i], gc_restore_visit);
+    for(size_t i = 0; i < gc_garbage.count; i++)
+        object_free_contents(gc_garbage.data[i]);
+    for(size_t i = 0; i < gc_garbage.count; i++)
+        _free(gc_garbage.data[i]);
+    size_t freed = langallocator_stats().bytes;
+    if(freed < bytes)
+        gc_num_bytes += bytes - freed;
+    gc_num_objects += gc_garbage.count;
+    gc_garbage.count = 0;
+}
+
+void gc_possible_root(object_t* obj) {
+    if(gc_threshold != 0) {
+        obj->gc_color = GC_COLOR_PURPLE;
+        if(!obj->gc_buffered) {
+            obj->gc_buffered = true;
+            gc_push(&gc_roots, obj);
+            if(gc_free_depth == 0 && gc_roots.count >= gc_limit)
+                gc_collect();
+        }
+    }
+}
+
+// A collection is put off while objects are being freed, a buffered root could be one of them
+void gc_begin_free() {
+    gc_free_depth++;
+}
+
+void gc_end_free() {
+    gc_free_depth--;
+    if(gc_free_depth == 0 && gc_roots.count >= gc_limit)
+        gc_collect();
+}
+
+void gc_collect() {
+    if(gc_collecting || gc_free_depth > 0 || gc_roots.count == 0)
+        return;
+    gc_collecting = true;
+    gc_traced = 0;
+
+    size_t num_roots = 0;
+    for(size_t i = 0; i < gc_roots.count; i++) {
+        object_t* obj = gc_roots.data[i];
+        if(obj->type != OBJECT_TYPE_FREED && obj->gc_color == GC_COLOR_PURPLE) {
+            gc_mark_gray(obj);
+            gc_roots.data[num_roots] = obj;
+            num_roots++;
+        } else {
+            // Objects freed while they were buffered are left for the collector to release
+            obj->gc_buffered = false;
+            if(obj->type == OBJECT_TYPE_FREED)
+                _free(obj);
+        }
+    }
+    gc_roots.count = num_roots;
+
+    for(size_t i = 0; i < gc_roots.count; i++)
+        gc_scan(gc_roots.data[i]);
+    for(size_t i = 0; i < gc_roots.count; i++) {
+        gc_roots.data[i]->gc_buffered = false;
+        gc_collect_white(gc_roots.data[i]);
+    }
+    gc_roots.count = 0;
+    gc_free_garbage();
+
+    gc_num_collections++;
+    gc_limit = gc_traced > gc_threshold ? gc_traced : gc_threshold;
+    gc_collecting = false;
+}
+
+void gc_print_stats() {
+    fprintf(stderr, "gc: %lu collections, %lu objects and %lu bytes collected\n",
+        gc_num_collections, gc_num_objects, gc_num_bytes);
+}
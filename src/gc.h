@@ -0,0 +1,31 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#ifndef __GC_H__
+#define __GC_H__
+
+#include "./types.h"
+#include "./bool.h"
+
+// Number of buffered possible roots that starts a collection. A collection does not start
+// before there are as many roots as the last one traced objects, so big heaps are traced less often.
+#define GC_DEFAULT_THRESHOLD 10000
+
+// Reference counting frees everything except cycles, for example a struct kept in a list it contains.
+// These are found by trial deletion: containers whose count dropped to a value other than zero are
+// buffered as possible roots. A collection subtracts the references between the objects reachable
+// from them, what is left at zero is only referenced by the cycle and gets freed.
+typedef enum gc_color_e {
+    GC_COLOR_BLACK,     // In use, or not looked at by the collector
+    GC_COLOR_GRAY,      // Reachable from a root, its internal references are subtracted
+    GC_COLOR_WHITE,     // Only referenced by other white objects
+    GC_COLOR_PURPLE,    // Possible root of a cycle
+} gc_color_t;
+
+void gc_set_threshold(size_t threshold); // 0 turns the collector off
+void gc_possible_root(object_t* obj);
+void gc_begin_free(); // Called around freeing an object, a collection waits until the outermost one ends
+void gc_end_free();
+void gc_collect(); // does nothing if the collector is off, as nothing is buffered then
+void gc_print_stats();
+
+#endif
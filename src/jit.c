@@ -0,0 +1,960 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "./jit.h"
+#include "./bytecode.h"
+#include "./object.h"
+#include "./variabletable.h"
+#include "./langallocator.h"
+
+#if defined(__x86_64__) && defined(__unix__)
+#include <sys/mman.h>
+#define JIT_X86_64
+#endif
+
+#define JIT_MAX_DEPTH 32
+#define JIT_LOCAL_SLOTS 64
+
+typedef enum jit_type_e {
+    JIT_TYPE_UNKNOWN,       // not a number or boolean, or a local of a function before its first assignment
+    JIT_TYPE_NUMBER,
+    JIT_TYPE_BOOL,
+} jit_type_t;
+
+typedef struct jit_var_s {
+    string_t* name;
+    jit_type_t type;
+    size_t slot;
+    size_t checkpoint;      // slot holding the value at the start of the current loop iteration
+    bool_t assigned;
+} jit_var_t;
+
+typedef struct jit_constant_s {
+    number_t value;
+    size_t slot;
+} jit_constant_t;
+
+typedef int (*jit_entry_t)(number_t* slots);
+
+// The code works on an array of slots holding the variables, constants and temporaries as doubles,
+// booleans are stored as 0 and 1. It returns 1 if it has to bail out to the interpreter.
+struct jit_s {
+    void* code;             // NULL if the operation could not be compiled
+    size_t code_size;
+    bool_t function;
+    unsigned int calls;     // calls of a function before it was compiled
+    unsigned int misses;
+    jit_var_t* vars;
+    size_t num_vars;
+    size_t num_params;      // the first variables of a function are its parameters
+    jit_constant_t* constants;
+    size_t num_constants;
+    size_t num_slots;
+    size_t result_slot;
+    jit_type_t result_type;
+    bool_t checkpoints;     // a loop restores the variables of the interrupted iteration when bailing out
+};
+
+typedef struct jit_fixup_s {
+    size_t pos;
+    size_t label;
+} jit_fixup_t;
+
+typedef struct jit_compiler_s {
+    unsigned char* code;
+    size_t length;
+    size_t size;
+    size_t* labels;
+    size_t num_labels;
+    size_t labels_size;
+    jit_fixup_t* fixups;
+    size_t num_fixups;
+    size_t fixups_size;
+    jit_var_t* vars;
+    size_t num_vars;
+    size_t vars_size;
+    jit_constant_t* constants;
+    size_t num_constants;
+    size_t constants_size;
+    size_t temps[JIT_MAX_DEPTH];
+    size_t num_temps;
+    size_t num_slots;
+    environment_t* env;     // variables of loops already exist in env, NULL for functions
+    int nesting;            // > 0 in code that is not executed every time
+    int scopes;             // > 0 inside a block, whose new variables are dropped at its end
+    bool_t failed;
+    bool_t bails;
+    size_t bail_label;
+    size_t checkpoint_label;
+    size_t checkpoint_back;
+    size_t checkpoint_pos;
+} jit_compiler_t;
+
+typedef enum jit_cc_e {
+    JIT_CC_JMP = -1,
+    JIT_CC_B = 0x2,
+    JIT_CC_AE = 0x3,
+    JIT_CC_E = 0x4,
+    JIT_CC_NE = 0x5,
+    JIT_CC_BE = 0x6,
+    JIT_CC_A = 0x7,
+    JIT_CC_P = 0xa,
+} jit_cc_t;
+
+#define JIT_SD 0xf2
+#define JIT_PD 0x66
+#define JIT_MOVSD_LOAD 0x10
+#define JIT_MOVSD_STORE 0x11
+#define JIT_MOVAPD 0x28
+#define JIT_UCOMISD 0x2e
+#define JIT_XORPD 0x57
+#define JIT_ADDSD 0x58
+#define JIT_MULSD 0x59
+#define JIT_SUBSD 0x5c
+#define JIT_DIVSD 0x5e
+
+#ifdef JIT_X86_64
+static bool_t jit_enabled = true;
+#else
+static bool_t jit_enabled = false;
+#endif
+
+static size_t jit_num_functions = 0;
+static size_t jit_num_loops = 0;
+static size_t jit_num_runs = 0;
+static size_t jit_num_bails = 0;
+
+void jit_set_enabled(bool_t enabled) {
+#ifdef JIT_X86_64
+    jit_enabled = enabled;
+#endif
+}
+
+bool_t jit_is_enabled() {
+    return jit_enabled;
+}
+
+void jit_print_stats() {
+    fprintf(stderr, "jit: %lu functions and %lu loops compiled, %lu runs, %lu bailouts\n",
+        jit_num_functions, jit_num_loops, jit_num_runs, jit_num_bails);
+}
+
+static void* jit_grow(void* data, size_t* size, size_t count, size_t elem_size) {
+    if(count == *size) {
+        *size = *size == 0 ? 8 : 2 * *size;
+        data = _realloc(data, elem_size * *size);
+    }
+    return data;
+}
+
+static void jit_emit(jit_compiler_t* c, const unsigned char* bytes, size_t n) {
+    if(c->length + n > c->size) {
+        c->size = 2 * (c->length + n);
+        c->code = (unsigned char*)_realloc(c->code, c->size);
+    }
+    memcpy(c->code + c->length, bytes, n);
+    c->length += n;
+}
+
+static void jit_emit_int32(jit_compiler_t* c, int32_t value) {
+    unsigned char bytes[4];
+    memcpy(bytes, &value, 4);
+    jit_emit(c, bytes, 4);
+}
+
+// prefix 0f opcode with the xmm register reg and the memory operand [rbx + slot*8]
+static void jit_emit_sse_slot(jit_compiler_t* c, unsigned char prefix, unsigned char opcode, int reg, size_t slot) {
+    unsigned char bytes[4] = { prefix, 0x0f, opcode, 0x83 | (reg << 3) };
+    jit_emit(c, bytes, 4);
+    jit_emit_int32(c, (int32_t)(slot * sizeof(number_t)));
+}
+
+// prefix 0f opcode with the xmm registers reg and rm
+static void jit_emit_sse(jit_compiler_t* c, unsigned char prefix, unsigned char opcode, int reg, int rm) {
+    unsigned char bytes[4] = { prefix, 0x0f, opcode, 0xc0 | (reg << 3) | rm };
+    jit_emit(c, bytes, 4);
+}
+
+#define JIT_EMIT(C, ...) { static const unsigned char bytes[] = { __VA_ARGS__ }; jit_emit(C, bytes, sizeof(bytes)); }
+
+static size_t jit_label(jit_compiler_t* c) {
+    c->labels = (size_t*)jit_grow(c->labels, &c->labels_size, c->num_labels, sizeof(size_t));
+    c->labels[c->num_labels] = 0;
+    return c->num_labels++;
+}
+
+static void jit_bind(jit_compiler_t* c, size_t label) {
+    c->labels[label] = c->length;
+}
+
+static void jit_jump(jit_compiler_t* c, jit_cc_t cc, size_t label) {
+    if(cc == JIT_CC_JMP) {
+        JIT_EMIT(c, 0xe9);
+    } else {
+        unsigned char bytes[2] = { 0x0f, 0x80 | cc };
+        jit_emit(c, bytes, 2);
+    }
+    c->fixups = (jit_fixup_t*)jit_grow(c->fixups, &c->fixups_size, c->num_fixups, sizeof(jit_fixup_t));
+    c->fixups[c->num_fixups].pos = c->length;
+    c->fixups[c->num_fixups].label = label;
+    c->num_fixups++;
+    jit_emit_int32(c, 0);
+}
+
+static void jit_bail(jit_compiler_t* c, jit_cc_t cc) {
+    c->bails = true;
+    jit_jump(c, cc, c->bail_label);
+}
+
+static size_t jit_temp(jit_compiler_t* c, size_t depth) {
+    if(depth >= JIT_MAX_DEPTH) {
+        c->failed = true;
+        return 0;
+    }
+    while(c->num_temps <= depth)
+        c->temps[c->num_temps++] = c->num_slots++;
+    return c->temps[depth];
+}
+
+static size_t jit_constant(jit_compiler_t* c, number_t value) {
+    for(size_t i = 0; i < c->num_constants; i++)
+        if(memcmp(&c->constants[i].value, &value, sizeof(number_t)) == 0)
+            return c->constants[i].slot;
+    c->constants = (jit_constant_t*)jit_grow(c->constants, &c->constants_size, c->num_constants, sizeof(jit_constant_t));
+    c->constants[c->num_constants].value = value;
+    c->constants[c->num_constants].slot = c->num_slots++;
+    return c->constants[c->num_constants++].slot;
+}
+
+// Looks name up like environment_get_var, but does not create it
+static object_t** jit_lookup(environment_t* env, string_t* name) {
+    for(long i = env->count-1; i >= (long)env->local_mode_limit; i--)
+        if(variabletable_exists(env->data[i], name))
+            return variabletable_get_loc(env->data[i], name);
+    return NULL;
+}
+
+static jit_type_t jit_object_type(object_t* obj) {
+    if(obj->type == OBJECT_TYPE_NUMBER)
+        return JIT_TYPE_NUMBER;
+    else if(obj->type == OBJECT_TYPE_BOOL)
+        return JIT_TYPE_BOOL;
+    else
+        return JIT_TYPE_UNKNOWN;
+}
+
+static jit_var_t* jit_add_var(jit_compiler_t* c, string_t* name, jit_type_t type) {
+    c->vars = (jit_var_t*)jit_grow(c->vars, &c->vars_size, c->num_vars, sizeof(jit_var_t));
+    jit_var_t* var = &c->vars[c->num_vars++];
+    var->name = string_copy(name);
+    var->type = type;
+    var->slot = c->num_slots++;
+    var->checkpoint = 0;
+    var->assigned = false;
+    return var;
+}
+
+// The returned pointer is only valid until the next variable is added
+static jit_var_t* jit_var(jit_compiler_t* c, string_t* name) {
+    for(size_t i = 0; i < c->num_vars; i++)
+        if(string_equ(c->vars[i].name, name))
+            return &c->vars[i];
+    jit_type_t type = JIT_TYPE_UNKNOWN;
+    if(c->env != NULL) {
+        object_t** loc = jit_lookup(c->env, name);
+        if(loc != NULL)
+            type = jit_object_type(*loc);
+        if(type == JIT_TYPE_UNKNOWN) {
+            c->failed = true;
+            return NULL;
+        }
+    } else if(c->scopes > 0) {
+        // A local created inside a block is gone after it, the slots do not model that
+        c->failed = true;
+        return NULL;
+    }
+    return jit_add_var(c, name, type);
+}
+
+static jit_var_t* jit_read_var(jit_compiler_t* c, operation_t* op) {
+    jit_var_t* var = jit_var(c, op->data.str);
+    if(var != NULL && var->type == JIT_TYPE_UNKNOWN) {
+        c->failed = true;
+        return NULL;
+    }
+    return var;
+}
+
+// Returns true and sets slot if op is a number literal or variable that can be used as a memory operand
+static bool_t jit_number_slot(jit_compiler_t* c, operation_t* op, size_t* slot) {
+    if(op != NULL && op->type == OPERATION_TYPE_NUM) {
+        *slot = jit_constant(c, op->data.num);
+        return true;
+    } else if(op != NULL && op->type == OPERATION_TYPE_VAR) {
+        jit_var_t* var = jit_read_var(c, op);
+        if(var != NULL && var->type == JIT_TYPE_NUMBER) {
+            *slot = var->slot;
+            return true;
+        }
+    }
+    return false;
+}
+
+static jit_type_t jit_compile_value(jit_compiler_t* c, operation_t* op, size_t depth);
+static jit_type_t jit_compile_branch(jit_compiler_t* c, operation_t* op, size_t depth, bool_t jump_if, size_t label);
+static void jit_compile_exec(jit_compiler_t* c, operation_t* op, size_t depth);
+
+// Leaves the value of left in xmm0 and of right in xmm1
+static bool_t jit_compile_operands(jit_compiler_t* c, operation_t* left, operation_t* right, size_t depth, jit_type_t type) {
+    size_t slot;
+    if(jit_compile_value(c, left, depth) != type)
+        return false;
+    if(type == JIT_TYPE_NUMBER && jit_number_slot(c, right, &slot)) {
+        jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_LOAD, 1, slot);
+    } else {
+        size_t tmp = jit_temp(c, depth);
+        jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_STORE, 0, tmp);
+        if(jit_compile_value(c, right, depth+1) != type)
+            return false;
+        jit_emit_sse(c, JIT_PD, JIT_MOVAPD, 1, 0);
+        jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_LOAD, 0, tmp);
+    }
+    return true;
+}
+
+static jit_type_t jit_compile_arithmetic(jit_compiler_t* c, operation_t* op, size_t depth) {
+    unsigned char opcode;
+    switch(op->type) {
+        case OPERATION_TYPE_ADD: opcode = JIT_ADDSD; break;
+        case OPERATION_TYPE_SUB: opcode = JIT_SUBSD; break;
+        case OPERATION_TYPE_MUL: opcode = JIT_MULSD; break;
+        default: opcode = JIT_DIVSD; break;
+    }
+    size_t num_op = bytecode_count_operations(op);
+    if(jit_compile_value(c, op->data.operations[0], depth) != JIT_TYPE_NUMBER)
+        return JIT_TYPE_UNKNOWN;
+    for(size_t i = 1; i < num_op; i++) {
+        size_t slot;
+        if(jit_number_slot(c, op->data.operations[i], &slot)) {
+            jit_emit_sse_slot(c, JIT_SD, opcode, 0, slot);
+        } else {
+            size_t tmp = jit_temp(c, depth);
+            jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_STORE, 0, tmp);
+            if(jit_compile_value(c, op->data.operations[i], depth+1) != JIT_TYPE_NUMBER)
+                return JIT_TYPE_UNKNOWN;
+            jit_emit_sse(c, JIT_PD, JIT_MOVAPD, 1, 0);
+            jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_LOAD, 0, tmp);
+            jit_emit_sse(c, JIT_SD, opcode, 0, 1);
+        }
+    }
+    return JIT_TYPE_NUMBER;
+}
+
+// The interpreter reports non-integer operands, so the code bails out and lets it
+static jit_type_t jit_compile_mod(jit_compiler_t* c, operation_t* op, size_t depth) {
+    size_t num_op = bytecode_count_operations(op);
+    if(jit_compile_value(c, op->data.operations[0], depth) != JIT_TYPE_NUMBER)
+        return JIT_TYPE_UNKNOWN;
+    JIT_EMIT(c,
+        0xf2, 0x48, 0x0f, 0x2c, 0xc0,   // cvttsd2si rax, xmm0
+        0xf2, 0x48, 0x0f, 0x2a, 0xd0,   // cvtsi2sd xmm2, rax
+        0x66, 0x0f, 0x2e, 0xc2);        // ucomisd xmm0, xmm2
+    jit_bail(c, JIT_CC_P);
+    jit_bail(c, JIT_CC_NE);
+    for(size_t i = 1; i < num_op; i++) {
+        size_t tmp = jit_temp(c, depth);
+        jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_STORE, 0, tmp);
+        if(jit_compile_value(c, op->data.operations[i], depth+1) != JIT_TYPE_NUMBER)
+            return JIT_TYPE_UNKNOWN;
+        jit_emit_sse(c, JIT_PD, JIT_MOVAPD, 1, 0);
+        jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_LOAD, 0, tmp);
+        JIT_EMIT(c,
+            0xf2, 0x48, 0x0f, 0x2c, 0xc9,   // cvttsd2si rcx, xmm1
+            0xf2, 0x48, 0x0f, 0x2a, 0xd1,   // cvtsi2sd xmm2, rcx
+            0x66, 0x0f, 0x2e, 0xca);        // ucomisd xmm1, xmm2
+        jit_bail(c, JIT_CC_P);
+        jit_bail(c, JIT_CC_NE);
+        JIT_EMIT(c,
+            0x48, 0x85, 0xc9);              // test rcx, rcx
+        jit_bail(c, JIT_CC_E);
+        JIT_EMIT(c,
+            0xf2, 0x48, 0x0f, 0x2c, 0xc0,   // cvttsd2si rax, xmm0
+            0x48, 0x99,                     // cqo
+            0x48, 0xf7, 0xf9,               // idiv rcx
+            0xf2, 0x48, 0x0f, 0x2a, 0xc2);  // cvtsi2sd xmm0, rdx
+    }
+    return JIT_TYPE_NUMBER;
+}
+
+// Like the interpreter, the exponent is truncated to an int
+static jit_type_t jit_compile_pow(jit_compiler_t* c, operation_t* op, size_t depth) {
+    if(bytecode_count_operations(op) != 2)
+        return JIT_TYPE_UNKNOWN;
+    size_t tmp = jit_temp(c, depth);
+    if(jit_compile_value(c, op->data.operations[0], depth) != JIT_TYPE_NUMBER)
+        return JIT_TYPE_UNKNOWN;
+    jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_STORE, 0, tmp);
+    if(jit_compile_value(c, op->data.operations[1], depth+1) != JIT_TYPE_NUMBER)
+        return JIT_TYPE_UNKNOWN;
+    JIT_EMIT(c,
+        0xf2, 0x0f, 0x2c, 0xc0,         // cvttsd2si eax, xmm0
+        0xf2, 0x0f, 0x2a, 0xc8);        // cvtsi2sd xmm1, eax
+    jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_LOAD, 0, tmp);
+    double (*function)(double, double) = pow;
+    uint64_t address = (uint64_t)(uintptr_t)function;
+    JIT_EMIT(c, 0x48, 0xb8);            // mov rax, address
+    jit_emit(c, (unsigned char*)&address, 8);
+    JIT_EMIT(c, 0xff, 0xd0);            // call rax
+    return JIT_TYPE_NUMBER;
+}
+
+static jit_type_t jit_compile_assign(jit_compiler_t* c, operation_t* op, size_t depth) {
+    operation_t* target = op->data.operations[0];
+    if(target == NULL || target->type != OPERATION_TYPE_VAR)
+        return JIT_TYPE_UNKNOWN;
+    jit_type_t type = jit_compile_value(c, op->data.operations[1], depth);
+    jit_var_t* var = jit_var(c, target->data.str);
+    if(type == JIT_TYPE_UNKNOWN || var == NULL)
+        return JIT_TYPE_UNKNOWN;
+    if(var->type == JIT_TYPE_UNKNOWN && c->nesting == 0)
+        var->type = type;
+    if(var->type != type)
+        return JIT_TYPE_UNKNOWN;
+    var->assigned = true;
+    jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_STORE, 0, var->slot);
+    return type;
+}
+
+static jit_type_t jit_compile_value(jit_compiler_t* c, operation_t* op, size_t depth) {
+    jit_type_t ret = JIT_TYPE_UNKNOWN;
+    if(op == NULL || c->failed) {
+        c->failed = true;
+        return JIT_TYPE_UNKNOWN;
+    }
+    switch(op->type) {
+        case OPERATION_TYPE_NUM:
+            jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_LOAD, 0, jit_constant(c, op->data.num));
+            ret = JIT_TYPE_NUMBER;
+            break;
+        case OPERATION_TYPE_BOOL:
+            jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_LOAD, 0, jit_constant(c, op->data.boolean ? 1 : 0));
+            ret = JIT_TYPE_BOOL;
+            break;
+        case OPERATION_TYPE_VAR: {
+            jit_var_t* var = jit_read_var(c, op);
+            if(var != NULL) {
+                jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_LOAD, 0, var->slot);
+                ret = var->type;
+            }
+        } break;
+        case OPERATION_TYPE_ASSIGN:
+            ret = jit_compile_assign(c, op, depth);
+            break;
+        case OPERATION_TYPE_PROC:
+        case OPERATION_TYPE_PROC_IMP: {
+            size_t num_op = bytecode_count_operations(op);
+            for(size_t i = 0; i+1 < num_op; i++)
+                jit_compile_exec(c, op->data.operations[i], depth);
+            ret = jit_compile_value(c, op->data.operations[num_op-1], depth);
+        } break;
+        case OPERATION_TYPE_SCOPE:
+            c->scopes++;
+            ret = jit_compile_value(c, op->data.operations[0], depth);
+            c->scopes--;
+            break;
+        case OPERATION_TYPE_ADD:
+        case OPERATION_TYPE_SUB:
+        case OPERATION_TYPE_MUL:
+        case OPERATION_TYPE_DIV:
+            ret = jit_compile_arithmetic(c, op, depth);
+            break;
+        case OPERATION_TYPE_MOD:
+            ret = jit_compile_mod(c, op, depth);
+            break;
+        case OPERATION_TYPE_POW:
+            ret = jit_compile_pow(c, op, depth);
+            break;
+        case OPERATION_TYPE_NEG:
+            if(jit_compile_value(c, op->data.operations[0], depth) == JIT_TYPE_NUMBER) {
+                jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_LOAD, 1, jit_constant(c, -0.0));
+                jit_emit_sse(c, JIT_PD, JIT_XORPD, 0, 1);
+                ret = JIT_TYPE_NUMBER;
+            }
+            break;
+        case OPERATION_TYPE_NOT:
+        case OPERATION_TYPE_AND:
+        case OPERATION_TYPE_OR:
+        case OPERATION_TYPE_EQU:
+        case OPERATION_TYPE_GTR:
+        case OPERATION_TYPE_LES:
+        case OPERATION_TYPE_LEQ:
+        case OPERATION_TYPE_GEQ: {
+            size_t is_false = jit_label(c);
+            size_t done = jit_label(c);
+            jit_compile_branch(c, op, depth, false, is_false);
+            jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_LOAD, 0, jit_constant(c, 1));
+            jit_jump(c, JIT_CC_JMP, done);
+            jit_bind(c, is_false);
+            jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_LOAD, 0, jit_constant(c, 0));
+            jit_bind(c, done);
+            ret = JIT_TYPE_BOOL;
+        } break;
+        default:
+            break;
+    }
+    if(ret == JIT_TYPE_UNKNOWN)
+        c->failed = true;
+    return ret;
+}
+
+// Jumps to label if the truth value of op equals jump_if, returns the type of op
+static jit_type_t jit_compile_branch(jit_compiler_t* c, operation_t* op, size_t depth, bool_t jump_if, size_t label) {
+    jit_type_t ret = JIT_TYPE_BOOL;
+    if(op == NULL || c->failed) {
+        c->failed = true;
+        return JIT_TYPE_UNKNOWN;
+    }
+    switch(op->type) {
+        case OPERATION_TYPE_BOOL:
+            if(op->data.boolean == jump_if)
+                jit_jump(c, JIT_CC_JMP, label);
+            break;
+        case OPERATION_TYPE_NOT:
+            if(jit_compile_branch(c, op->data.operations[0], depth, !jump_if, label) != JIT_TYPE_BOOL)
+                ret = JIT_TYPE_UNKNOWN;
+            break;
+        case OPERATION_TYPE_AND:
+        case OPERATION_TYPE_OR: {
+            // An operand that decides the result skips the remaining ones
+            bool_t decides = op->type == OPERATION_TYPE_OR;
+            size_t num_op = bytecode_count_operations(op);
+            size_t skip = jit_label(c);
+            for(size_t i = 0; i < num_op; i++) {
+                bool_t last = i+1 == num_op;
+                if(i == 1)
+                    c->nesting++;
+                if(jit_compile_branch(c, op->data.operations[i], depth, last ? jump_if : decides,
+                    last || decides == jump_if ? label : skip) != JIT_TYPE_BOOL)
+                    ret = JIT_TYPE_UNKNOWN;
+            }
+            if(num_op > 1)
+                c->nesting--;
+            jit_bind(c, skip);
+        } break;
+        case OPERATION_TYPE_EQU:
+        case OPERATION_TYPE_GTR:
+        case OPERATION_TYPE_LES:
+        case OPERATION_TYPE_LEQ:
+        case OPERATION_TYPE_GEQ: {
+            jit_type_t type = JIT_TYPE_NUMBER;
+            if(op->type == OPERATION_TYPE_EQU) {
+                // Both operands of an equality have to be of the same type
+                operation_t* left = op->data.operations[0];
+                if(left != NULL && (left->type == OPERATION_TYPE_BOOL || left->type == OPERATION_TYPE_NOT
+                    || left->type == OPERATION_TYPE_AND || left->type == OPERATION_TYPE_OR || left->type == OPERATION_TYPE_EQU
+                    || left->type == OPERATION_TYPE_GTR || left->type == OPERATION_TYPE_LES
+                    || left->type == OPERATION_TYPE_LEQ || left->type == OPERATION_TYPE_GEQ))
+                    type = JIT_TYPE_BOOL;
+                else if(left != NULL && left->type == OPERATION_TYPE_VAR) {
+                    jit_var_t* var = jit_read_var(c, left);
+                    if(var != NULL)
+                        type = var->type;
+                }
+            }
+            if(!jit_compile_operands(c, op->data.operations[0], op->data.operations[1], depth, type)) {
+                ret = JIT_TYPE_UNKNOWN;
+                break;
+            }
+            switch(op->type) {
+                case OPERATION_TYPE_LES:
+                    jit_emit_sse(c, JIT_PD, JIT_UCOMISD, 1, 0);
+                    jit_jump(c, jump_if ? JIT_CC_A : JIT_CC_BE, label);
+                    break;
+                case OPERATION_TYPE_GTR:
+                    jit_emit_sse(c, JIT_PD, JIT_UCOMISD, 0, 1);
+                    jit_jump(c, jump_if ? JIT_CC_A : JIT_CC_BE, label);
+                    break;
+                case OPERATION_TYPE_LEQ:
+                    jit_emit_sse(c, JIT_PD, JIT_UCOMISD, 1, 0);
+                    jit_jump(c, jump_if ? JIT_CC_AE : JIT_CC_B, label);
+                    break;
+                case OPERATION_TYPE_GEQ:
+                    jit_emit_sse(c, JIT_PD, JIT_UCOMISD, 0, 1);
+                    jit_jump(c, jump_if ? JIT_CC_AE : JIT_CC_B, label);
+                    break;
+                default:
+                    jit_emit_sse(c, JIT_PD, JIT_UCOMISD, 0, 1);
+                    if(jump_if) {
+                        size_t unordered = jit_label(c);
+                        jit_jump(c, JIT_CC_P, unordered);
+                        jit_jump(c, JIT_CC_E, label);
+                        jit_bind(c, unordered);
+                    } else {
+                        jit_jump(c, JIT_CC_P, label);
+                        jit_jump(c, JIT_CC_NE, label);
+                    }
+                    break;
+            }
+        } break;
+        default:
+            // Any other number or boolean, numbers other than 0 (including NaN) are true
+            ret = jit_compile_value(c, op, depth);
+            if(ret != JIT_TYPE_UNKNOWN) {
+                jit_emit_sse_slot(c, JIT_PD, JIT_UCOMISD, 0, jit_constant(c, 0));
+                if(ret == JIT_TYPE_BOOL) {
+                    jit_jump(c, jump_if ? JIT_CC_NE : JIT_CC_E, label);
+                } else if(jump_if) {
+                    jit_jump(c, JIT_CC_P, label);
+                    jit_jump(c, JIT_CC_NE, label);
+                } else {
+                    size_t unordered = jit_label(c);
+                    jit_jump(c, JIT_CC_P, unordered);
+                    jit_jump(c, JIT_CC_E, label);
+                    jit_bind(c, unordered);
+                }
+            }
+            break;
+    }
+    if(ret == JIT_TYPE_UNKNOWN)
+        c->failed = true;
+    return ret;
+}
+
+// The loop at the head of the compiled code saves the assigned variables at the start of every iteration
+static void jit_compile_loop(jit_compiler_t* c, operation_t* cond, operation_t* body, operation_t* step, size_t depth, bool_t head) {
+    size_t start = jit_label(c);
+    size_t end = jit_label(c);
+    c->nesting++;
+    jit_bind(c, start);
+    if(head) {
+        c->checkpoint_pos = c->length;
+        jit_jump(c, JIT_CC_JMP, c->checkpoint_label);
+        jit_bind(c, c->checkpoint_back);
+    }
+    jit_compile_branch(c, cond, depth, false, end);
+    jit_compile_exec(c, body, depth);
+    jit_compile_exec(c, step, depth);
+    jit_jump(c, JIT_CC_JMP, start);
+    jit_bind(c, end);
+    c->nesting--;
+}
+
+static void jit_compile_exec(jit_compiler_t* c, operation_t* op, size_t depth) {
+    if(op == NULL || c->failed)
+        return;
+    switch(op->type) {
+        case OPERATION_TYPE_NOOP:
+        case OPERATION_TYPE_NOOP_BRAC:
+        case OPERATION_TYPE_NOOP_EMP_REC:
+        case OPERATION_TYPE_NOOP_O_LIST_DEADEND:
+        case OPERATION_TYPE_NOOP_PROC_DEADEND:
+        case OPERATION_TYPE_NOOP_PLUS:
+        case OPERATION_TYPE_NOOP_EMP_CUR:
+        case OPERATION_TYPE_NONE:
+        case OPERATION_TYPE_NUM:
+        case OPERATION_TYPE_STR:
+        case OPERATION_TYPE_BOOL:
+            break;
+        case OPERATION_TYPE_VAR:
+            jit_read_var(c, op);
+            break;
+        case OPERATION_TYPE_PROC:
+        case OPERATION_TYPE_PROC_IMP: {
+            size_t num_op = bytecode_count_operations(op);
+            for(size_t i = 0; i < num_op; i++)
+                jit_compile_exec(c, op->data.operations[i], depth);
+        } break;
+        case OPERATION_TYPE_SCOPE:
+            c->scopes++;
+            jit_compile_exec(c, op->data.operations[0], depth);
+            c->scopes--;
+            break;
+        case OPERATION_TYPE_IF:
+        case OPERATION_TYPE_IFELSE: {
+            size_t is_false = jit_label(c);
+            jit_compile_branch(c, op->data.operations[0], depth, false, is_false);
+            c->nesting++;
+            jit_compile_exec(c, op->data.operations[1], depth);
+            if(op->type == OPERATION_TYPE_IFELSE) {
+                size_t done = jit_label(c);
+                jit_jump(c, JIT_CC_JMP, done);
+                jit_bind(c, is_false);
+                jit_compile_exec(c, op->data.operations[2], depth);
+                jit_bind(c, done);
+            } else
+                jit_bind(c, is_false);
+            c->nesting--;
+        } break;
+        case OPERATION_TYPE_WHILE:
+            jit_compile_loop(c, op->data.operations[0], op->data.operations[1], NULL, depth, false);
+            break;
+        case OPERATION_TYPE_FOR:
+            jit_compile_exec(c, op->data.operations[0], depth);
+            jit_compile_loop(c, op->data.operations[1], op->data.operations[3], op->data.operations[2], depth, false);
+            break;
+        default:
+            jit_compile_value(c, op, depth);
+            break;
+    }
+}
+
+static void jit_compiler_init(jit_compiler_t* c, environment_t* env) {
+    memset(c, 0, sizeof(jit_compiler_t));
+    c->env = env;
+    c->bail_label = jit_label(c);
+    c->checkpoint_label = jit_label(c);
+    c->checkpoint_back = jit_label(c);
+    JIT_EMIT(c,
+        0x53,                           // push rbx
+        0x48, 0x89, 0xfb);              // mov rbx, rdi
+}
+
+static void jit_compiler_free(jit_compiler_t* c) {
+    _free(c->code);
+    _free(c->labels);
+    _free(c->fixups);
+    _free(c->constants);
+    if(c->vars != NULL) {
+        for(size_t i = 0; i < c->num_vars; i++)
+            string_free(c->vars[i].name);
+        _free(c->vars);
+    }
+}
+
+// Emits the exits, resolves the jumps and moves the code into executable memory
+static void jit_compiler_finish(jit_compiler_t* c, jit_t* jit) {
+    JIT_EMIT(c,
+        0x31, 0xc0,                     // xor eax, eax
+        0x5b,                           // pop rbx
+        0xc3);                          // ret
+    jit_bind(c, c->bail_label);
+    JIT_EMIT(c,
+        0xb8, 0x01, 0x00, 0x00, 0x00,   // mov eax, 1
+        0x5b,                           // pop rbx
+        0xc3);                          // ret
+    jit_bind(c, c->checkpoint_label);
+    if(jit->checkpoints) {
+        for(size_t i = 0; i < c->num_vars; i++)
+            if(c->vars[i].assigned) {
+                c->vars[i].checkpoint = c->num_slots++;
+                jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_LOAD, 0, c->vars[i].slot);
+                jit_emit_sse_slot(c, JIT_SD, JIT_MOVSD_STORE, 0, c->vars[i].checkpoint);
+            }
+        jit_jump(c, JIT_CC_JMP, c->checkpoint_back);
+    }
+    for(size_t i = 0; i < c->num_fixups; i++) {
+        int32_t rel = (int32_t)c->labels[c->fixups[i].label] - (int32_t)(c->fixups[i].pos + 4);
+        memcpy(c->code + c->fixups[i].pos, &rel, 4);
+    }
+    if(!jit->checkpoints && !jit->function) {
+        // nop dword [rax+rax*1+0] in place of the jump to the checkpoint
+        static const unsigned char nop[5] = { 0x0f, 0x1f, 0x44, 0x00, 0x00 };
+        memcpy(c->code + c->checkpoint_pos, nop, 5);
+    }
+
+#ifdef JIT_X86_64
+    size_t page = 4096;
+    jit->code_size = (c->length + page - 1) / page * page;
+    void* code = mmap(NULL, jit->code_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(code == MAP_FAILED) {
+        jit_enabled = false;
+        return;
+    }
+    memcpy(code, c->code, c->length);
+    if(mprotect(code, jit->code_size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(code, jit->code_size);
+        jit_enabled = false;
+        return;
+    }
+    jit->code = code;
+#endif
+
+    jit->vars = c->vars;
+    jit->num_vars = c->num_vars;
+    c->vars = NULL;
+    jit->constants = c->constants;
+    jit->num_constants = c->num_constants;
+    c->constants = NULL;
+    jit->num_slots = c->num_slots;
+}
+
+static jit_t* jit_create(bool_t function) {
+    jit_t* ret = (jit_t*)_alloc(sizeof(jit_t));
+    memset(ret, 0, sizeof(jit_t));
+    ret->function = function;
+    return ret;
+}
+
+static void jit_compile_loop_region(jit_t* jit, operation_t* op, environment_t* env) {
+    jit_compiler_t c;
+    jit_compiler_init(&c, env);
+    if(op->type == OPERATION_TYPE_FOR)
+        jit_compile_loop(&c, op->data.operations[1], op->data.operations[3], op->data.operations[2], 0, true);
+    else
+        jit_compile_loop(&c, op->data.operations[0], op->data.operations[1], NULL, 0, true);
+    if(!c.failed) {
+        jit->checkpoints = c.bails;
+        jit_compiler_finish(&c, jit);
+        if(jit->code != NULL)
+            jit_num_loops++;
+    }
+    jit_compiler_free(&c);
+}
+
+static void jit_compile_function(jit_t* jit, function_t* func, object_t** par) {
+    jit_compiler_t c;
+    jit_compiler_init(&c, NULL);
+    for(size_t i = 0; i < func->num_par; i++)
+        jit_add_var(&c, func->par_names[i], jit_object_type(par[i]));
+    // A parameter given twice is bound to the last argument
+    for(size_t i = 0; i < func->num_par; i++)
+        for(size_t j = i+1; j < func->num_par; j++)
+            if(string_equ(func->par_names[i], func->par_names[j]))
+                c.failed = true;
+    jit->num_params = func->num_par;
+    jit->result_type = jit_compile_value(&c, func->function, 0);
+    jit->result_slot = c.num_slots++;
+    jit_emit_sse_slot(&c, JIT_SD, JIT_MOVSD_STORE, 0, jit->result_slot);
+    if(!c.failed) {
+        jit_compiler_finish(&c, jit);
+        if(jit->code != NULL)
+            jit_num_functions++;
+    }
+    jit_compiler_free(&c);
+}
+
+static void jit_fill_constants(jit_t* jit, number_t* slots) {
+    for(size_t i = 0; i < jit->num_constants; i++)
+        slots[jit->constants[i].slot] = jit->constants[i].value;
+}
+
+static object_t* jit_object(jit_type_t type, number_t value) {
+    if(type == JIT_TYPE_BOOL)
+        return object_create_boolean(value != 0);
+    else
+        return object_create_number(value);
+}
+
+bool_t jit_run_loop(operation_t* op, environment_t* env) {
+    if(!jit_enabled)
+        return false;
+    if(op->jit == NULL) {
+        op->jit = jit_create(false);
+        jit_compile_loop_region(op->jit, op, env);
+    }
+    jit_t* jit = op->jit;
+    if(jit->code == NULL || jit->function)
+        return false;
+
+    number_t slots_buffer[JIT_LOCAL_SLOTS];
+    object_t** locs_buffer[JIT_LOCAL_SLOTS];
+    number_t* slots = jit->num_slots > JIT_LOCAL_SLOTS ? (number_t*)_alloc(sizeof(number_t)*jit->num_slots) : slots_buffer;
+    object_t*** locs = jit->num_vars > JIT_LOCAL_SLOTS ? (object_t***)_alloc(sizeof(object_t**)*jit->num_vars) : locs_buffer;
+    bool_t ret = true;
+    for(size_t i = 0; ret && i < jit->num_vars; i++) {
+        locs[i] = jit_lookup(env, jit->vars[i].name);
+        if(locs[i] == NULL || jit_object_type(*locs[i]) != jit->vars[i].type)
+            ret = false;
+        else if(jit->vars[i].type == JIT_TYPE_BOOL)
+            slots[jit->vars[i].slot] = (*locs[i])->data.boolean ? 1 : 0;
+        else
+            slots[jit->vars[i].slot] = (*locs[i])->data.number;
+    }
+
+    if(ret) {
+        jit_fill_constants(jit, slots);
+        jit_num_runs++;
+        if(((jit_entry_t)jit->code)(slots) != 0) {
+            // Restart the interrupted iteration in the interpreter
+            jit_num_bails++;
+            for(size_t i = 0; i < jit->num_vars; i++)
+                if(jit->vars[i].assigned)
+                    slots[jit->vars[i].slot] = slots[jit->vars[i].checkpoint];
+            ret = false;
+        }
+        for(size_t i = 0; i < jit->num_vars; i++)
+            if(jit->vars[i].assigned) {
+                object_dereference(*locs[i]);
+                *locs[i] = jit_object(jit->vars[i].type, slots[jit->vars[i].slot]);
+                object_reference(*locs[i]);
+            }
+    } else if(++jit->misses >= JIT_MAX_MISSES) {
+        jit_free(jit);
+        op->jit = jit_create(false);
+    }
+
+    if(slots != slots_buffer)
+        _free(slots);
+    if(locs != locs_buffer)
+        _free(locs);
+    return ret;
+}
+
+bool_t jit_run_function(function_t* func, object_t** par, object_t*** ret) {
+    if(!jit_enabled || func->par_names == NULL || par == NULL)
+        return false;
+    size_t num_par = 0;
+    while(par[num_par] != NULL) {
+        if(num_par == func->num_par || jit_object_type(par[num_par]) == JIT_TYPE_UNKNOWN)
+            return false;
+        num_par++;
+    }
+    if(num_par != func->num_par)
+        return false;
+
+    operation_t* op = func->function;
+    if(op->jit == NULL)
+        op->jit = jit_create(true);
+    jit_t* jit = op->jit;
+    if(!jit->function)
+        return false;
+    if(jit->calls < JIT_FUNCTION_THRESHOLD) {
+        if(++jit->calls == JIT_FUNCTION_THRESHOLD)
+            jit_compile_function(jit, func, par);
+        else
+            return false;
+    }
+    if(jit->code == NULL)
+        return false;
+    for(size_t i = 0; i < num_par; i++)
+        if(jit_object_type(par[i]) != jit->vars[i].type)
+            return false;
+
+    number_t slots_buffer[JIT_LOCAL_SLOTS];
+    number_t* slots = jit->num_slots > JIT_LOCAL_SLOTS ? (number_t*)_alloc(sizeof(number_t)*jit->num_slots) : slots_buffer;
+    for(size_t i = 0; i < num_par; i++)
+        slots[jit->vars[i].slot] = jit->vars[i].type == JIT_TYPE_BOOL ? (par[i]->data.boolean ? 1 : 0) : par[i]->data.number;
+    jit_fill_constants(jit, slots);
+    jit_num_runs++;
+    bool_t done = ((jit_entry_t)jit->code)(slots) == 0;
+    if(done) {
+        *ret = (object_t**)_alloc(sizeof(object_t*)*2);
+        (*ret)[0] = jit_object(jit->result_type, slots[jit->result_slot]);
+        object_reference((*ret)[0]);
+        (*ret)[1] = NULL;
+    } else
+        jit_num_bails++;
+    if(slots != slots_buffer)
+        _free(slots);
+    return done;
+}
+
+void jit_free(jit_t* jit) {
+    if(jit != NULL) {
+#ifdef JIT_X86_64
+        if(jit->code != NULL)
+            munmap(jit->code, jit->code_size);
+#endif
+        if(jit->vars != NULL) {
+            for(size_t i = 0; i < jit->num_vars; i++)
+                string_free(jit->vars[i].name);
+            _free(jit->vars);
+        }
+        _free(jit->constants);
+        _free(jit);
+    }
+}
@@ -0,0 +1,28 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#ifndef __JIT_H__
+#define __JIT_H__
+
+#include "./types.h"
+#include "./operation.h"
+#include "./environment.h"
+#include "./function.h"
+
+// Functions are compiled once they were called this often with number and boolean arguments
+#define JIT_FUNCTION_THRESHOLD 8
+// Entries with other variable types than the compiled ones before the code is given up
+#define JIT_MAX_MISSES 8
+
+typedef struct jit_s jit_t;
+
+void jit_set_enabled(bool_t enabled); // Only has an effect on x86-64
+bool_t jit_is_enabled();
+void jit_print_stats();
+// Runs the while or for loop op (without its initialization) in machine code, returns false if
+// it was not run, in that case the loop has to be interpreted from its condition on
+bool_t jit_run_loop(operation_t* op, environment_t* env);
+// Runs func in machine code, returns false if it was not run
+bool_t jit_run_function(function_t* func, object_t** par, object_t*** ret);
+void jit_free(jit_t* jit);
+
+#endif
@@ -1 +1,122 @@
 // Copyright (c) 2018-2019 Roland Bernard
+
+#include <string.h>
+#include <sys/mman.h>
+
+#include "./langallocator.h"
+
+#define NUM_CLASSES (LANGALLOCATOR_MAX_SMALL / LANGALLOCATOR_GRANULE + 1)
+#define CLASS_LARGE 0
+#define LARGE_OFFSET 2 // Big blocks keep the 16 byte alignment of malloc, the first header holds their size
+
+// Every block starts with its size class, so _free does not need the size
+typedef union langallocator_header_u {
+    size_t size_class;
+    union langallocator_header_u* next;
+} langallocator_header_t;
+
+static __thread langallocator_header_t* free_lists[NUM_CLASSES];
+static __thread char* slab_pos = NULL;
+static __thread char* slab_end = NULL;
+static __thread langallocator_stats_t stats;
+
+static size_t langallocator_class_of(size_t size) {
+    return size == 0 ? 1 : (size + LANGALLOCATOR_GRANULE - 1) / LANGALLOCATOR_GRANULE;
+}
+
+static langallocator_header_t* langallocator_carve(size_t size_class) {
+    size_t block_size = sizeof(langallocator_header_t) + size_class * LANGALLOCATOR_GRANULE;
+    if(slab_pos == NULL || slab_end - slab_pos < block_size) {
+        // The rest of the old slab is handed to the free lists of the smaller classes
+        while(slab_pos != NULL && slab_end - slab_pos >= sizeof(langallocator_header_t) + LANGALLOCATOR_GRANULE) {
+            size_t rest_class = (slab_end - slab_pos - sizeof(langallocator_header_t)) / LANGALLOCATOR_GRANULE;
+            if(rest_class >= NUM_CLASSES)
+                rest_class = NUM_CLASSES - 1;
+            langallocator_header_t* rest = (langallocator_header_t*)slab_pos;
+            rest->next = free_lists[rest_class];
+            free_lists[rest_class] = rest;
+            slab_pos += sizeof(langallocator_header_t) + rest_class * LANGALLOCATOR_GRANULE;
+        }
+        // Slabs are mapped directly, so they do not fragment the heap used by big blocks
+        slab_pos = (char*)mmap(NULL, LANGALLOCATOR_SLAB_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(slab_pos == MAP_FAILED) {
+            slab_pos = NULL;
+            return NULL;
+        }
+        slab_end = slab_pos + LANGALLOCATOR_SLAB_SIZE;
+        stats.slabs++;
+    }
+    langallocator_header_t* ret = (langallocator_header_t*)slab_pos;
+    slab_pos += block_size;
+    return ret;
+}
+
+void* langallocator_alloc(size_t size) {
+    langallocator_header_t* block;
+    stats.allocations++;
+    if(size > LANGALLOCATOR_MAX_SMALL) {
+        block = (langallocator_header_t*)malloc(LARGE_OFFSET*sizeof(langallocator_header_t) + size);
+        if(block == NULL)
+            return NULL;
+        block->size_class = size;
+        block += LARGE_OFFSET - 1;
+        block->size_class = CLASS_LARGE;
+        stats.bytes += size;
+    } else {
+        size_t size_class = langallocator_class_of(size);
+        block = free_lists[size_class];
+        if(block != NULL)
+            free_lists[size_class] = block->next;
+        else if((block = langallocator_carve(size_class)) == NULL)
+            return NULL;
+        block->size_class = size_class;
+        stats.bytes += size_class * LANGALLOCATOR_GRANULE;
+    }
+    return block + 1;
+}
+
+void* langallocator_realloc(void* ptr, size_t size) {
+    if(ptr == NULL)
+        return langallocator_alloc(size);
+    langallocator_header_t* block = (langallocator_header_t*)ptr - 1;
+    if(block->size_class == CLASS_LARGE && size > LANGALLOCATOR_MAX_SMALL) {
+        size_t old_size = (block - (LARGE_OFFSET - 1))->size_class;
+        block = (langallocator_header_t*)realloc(block - (LARGE_OFFSET - 1), LARGE_OFFSET*sizeof(langallocator_header_t) + size);
+        if(block == NULL)
+            return NULL;
+        block->size_class = size;
+        stats.bytes += size - old_size;
+        return block + LARGE_OFFSET;
+    } else if(block->size_class != CLASS_LARGE && size <= block->size_class * LANGALLOCATOR_GRANULE) {
+        return ptr;
+    } else {
+        void* ret = langallocator_alloc(size);
+        if(ret != NULL) {
+            size_t old_size = block->size_class == CLASS_LARGE ? LANGALLOCATOR_MAX_SMALL + 1 : block->size_class * LANGALLOCATOR_GRANULE;
+            memcpy(ret, ptr, old_size < size ? old_size : size);
+            langallocator_free(ptr);
+        }
+        return ret;
+    }
+}
+
+void langallocator_free(void* ptr) {
+    if(ptr != NULL) {
+        langallocator_header_t* block = (langallocator_header_t*)ptr - 1;
+        stats.frees++;
+        if(block->size_class == CLASS_LARGE) {
+            block -= LARGE_OFFSET - 1;
+            stats.bytes -= block->size_class;
+            free(block);
+        } else {
+            size_t size_class = block->size_class;
+            stats.bytes -= size_class * LANGALLOCATOR_GRANULE;
+            block->next = free_lists[size_class];
+            free_lists[size_class] = block;
+        }
+    }
+}
+
+langallocator_stats_t langallocator_stats() {
+    return stats;
+}
@@ -1,6 +1,7 @@
 // Copyright (c) 2018-2019 Roland Bernard
 
 #include <math.h>
+#include <string.h>
 
 #include "./list.h"
 #include "./object.h"
@@ -12,6 +13,8 @@ list_t* list_create_empty() {
 
     ret->data = NULL;
     ret->size = 0;
+    ret->capacity = 0;
+    ret->num_shared = NULL;
 
     return ret;
 }
@@ -20,6 +23,8 @@ list_t* list_create_null(size_t size) {
     list_t* ret = (list_t*)_alloc(sizeof(list_t));
 
     ret->data = (object_t**)_alloc(size * sizeof(object_t*));
+    ret->capacity = size;
+    ret->num_shared = NULL;
     ret->size = 0;
     while(ret->size < size) {
         ret->data[ret->size] = NULL;
@@ -33,23 +38,47 @@ list_t* list_copy(list_t* list) {
     list_t* ret = NULL;
 
     if(list != NULL) {
-        ret = (list_t*)_alloc(sizeof(list_t));
-        ret->data = (object_t**)_alloc(sizeof(object_t*) * list->size);
-        for(ret->size = 0; ret->size < list->size; ret->size++) {
-            ret->data[ret->size] = list->data[ret->size];
-            object_reference(ret->data[ret->size]);
+        if(list->size == 0)
+            return list_create_empty();
+        if(list->num_shared == NULL) {
+            list->num_shared = (size_t*)_alloc(sizeof(size_t));
+            *list->num_shared = 1;
         }
+        (*list->num_shared)++;
+        ret = (list_t*)_alloc(sizeof(list_t));
+        ret->data = list->data;
+        ret->size = list->size;
+        ret->capacity = list->capacity;
+        ret->num_shared = list->num_shared;
     }
 
     return ret;
 }
 
+// Gives the list its own copy of the elements before it is changed
+static void list_make_unique(list_t* list) {
+    if(list->num_shared != NULL) {
+        if(*list->num_shared > 1) {
+            (*list->num_shared)--;
+            object_t** data = (object_t**)_alloc(sizeof(object_t*) * list->capacity);
+            memcpy(data, list->data, sizeof(object_t*) * list->size);
+            for(size_t i = 0; i < list->size; i++)
+                object_reference(data[i]);
+            list->data = data;
+        } else
+            _free(list->num_shared);
+        list->num_shared = NULL;
+    }
+}
+
 list_t* list_add(list_t* l1, list_t* l2) {
     list_t* ret = NULL;
     
     if(l1 != NULL && l2 != NULL) {
         ret = (list_t*)_alloc(sizeof(list_t));
         ret->data = (object_t**)_alloc((l1->size + l2->size) * sizeof(object_t*));
+        ret->capacity = l1->size + l2->size;
+        ret->num_shared = NULL;
         ret->size = 0;
         while(ret->size < l1->size) {
             ret->data[ret->size] = l1->data[ret->size];
@@ -72,6 +101,8 @@ list_t* list_mul(list_t* list, size_t n) {
     if(list != NULL) {
         ret = (list_t*)_alloc(sizeof(list_t));
         ret->data = (object_t**)_alloc(list->size * n * sizeof(object_t*));
+        ret->capacity = list->size * n;
+        ret->num_shared = NULL;
         ret->size = 0;
         while(ret->size < list->size * n) {
             ret->data[ret->size] = list->data[ret->size % list->size];
@@ -91,6 +122,8 @@ list_t* list_range(list_t* list, pos_t pos, pos_t n) {
             ret = (list_t*)_alloc(sizeof(list_t));
             ret->data = (object_t**)_alloc(n * sizeof(object_t*));
             ret->size = n;
+            ret->capacity = n;
+            ret->num_shared = NULL;
             while(n--) {
                 ret->data[n] = list->data[pos + n];
                 object_reference(ret->data[n]);
@@ -101,6 +134,8 @@ list_t* list_range(list_t* list, pos_t pos, pos_t n) {
             ret = (list_t*)_alloc(sizeof(list_t));
             ret->data = (object_t**)_alloc((-n) * sizeof(object_t*));
             ret->size = -n;
+            ret->capacity = -n;
+            ret->num_shared = NULL;
             while(n++) {
                 ret->data[-n] = list->data[pos + n];
                 object_reference(ret->data[-n]);
@@ -137,8 +172,8 @@ object_t** list_get_loc(list_t* list, pos_t pos) {
     if(list != NULL) {
         if(pos >= list->size || pos < 0)
             return NULL;
-        else
-            return &(list->data[pos]);
+        list_make_unique(list);
+        return &(list->data[pos]);
     } else 
         return NULL;
 }
@@ -151,11 +186,10 @@ size_t list_size(list_t* list) {
 }
 
 id_t list_id(list_t* list) {
-    long hash = 0;
-    for (int i = 0; i < list->size; i++) {
-        hash += (long)pow(BIG_PRIME_3, list->size - (i+1)) * object_id(list->data[i]);
-    }
-    return (id_t)hash;
+    id_t hash = list->size;
+    for (int i = 0; i < list->size; i++)
+        hash = hash_combine(hash, object_id(list->data[i]));
+    return hash;
 }
 
 bool_t list_equ(list_t* l1, list_t* l2) {
@@ -171,28 +205,64 @@ bool_t list_equ(list_t* l1, list_t* l2) {
         return l1 == l2;
 }
 
+void list_reserve(list_t* list, size_t capacity) {
+    if(list != NULL)
+        list_make_unique(list);
+    if(list != NULL && capacity > list->capacity) {
+        list->data = (object_t**)_realloc(list->data, capacity * sizeof(object_t*));
+        list->capacity = capacity;
+    }
+}
+
+static void list_grow(list_t* list, size_t size) {
+    if(size > list->capacity) {
+        size_t capacity = list->capacity < 4 ? 4 : list->capacity * 2;
+        while(capacity < size)
+            capacity *= 2;
+        list_reserve(list, capacity);
+    }
+}
+
 void list_append(list_t* list, object_t* obj) {
     if(list != NULL) {
-        int i;
-        object_t** tmp = (object_t**)_alloc((list->size + 1) * sizeof(object_t*));
-        for(i = 0; i < list->size; i++)
-            tmp[i] = list->data[i];
-        tmp[i] = obj;
+        list_make_unique(list);
+        list_grow(list, list->size + 1);
+        list->data[list->size] = obj;
         object_reference(obj);
-        if(list->data != NULL)
-            _free(list->data);
-        list->data = tmp;
         list->size++;
     }
 }
 
+void list_append_all(list_t* list, object_t** objs, size_t n) {
+    if(list != NULL) {
+        list_make_unique(list);
+        list_grow(list, list->size + n);
+        for(size_t i = 0; i < n; i++) {
+            list->data[list->size + i] = objs[i];
+            object_reference(objs[i]);
+        }
+        list->size += n;
+    }
+}
+
+void list_visit(list_t* list, object_visitor_t visit) {
+    if(list != NULL && (list->num_shared == NULL || *list->num_shared == 1))
+        for(size_t i = 0; i < list->size; i++)
+            visit(list->data[i]);
+}
+
 void list_free(list_t* list) {
     if(list != NULL) {
-        for(int i = 0; i < list->size; i++)
-            object_dereference(list->data[i]);
-        if(list->data != NULL)
-            _free(list->data);
+        if(list->num_shared != NULL && *list->num_shared > 1) {
+            (*list->num_shared)--;
+        } else {
+            for(int i = 0; i < list->size; i++)
+                object_dereference(list->data[i]);
+            if(list->data != NULL)
+                _free(list->data);
+            _free(list->num_shared);
+        }
         list->size = 0;
         _free(list);
     }
-}
\ No newline at end of file
+}
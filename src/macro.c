@@ -3,7 +3,8 @@
 #include "./macro.h"
 
 macro_t* macro_create(operation_t* mac) {
-    return operation_copy(mac);
+    operation_reference(mac);
+    return mac;
 }
 
 void* macro_exec(macro_t* mac, environment_t* env) {
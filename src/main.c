@@ -12,6 +12,9 @@
 #include "./string.h"
 #include "./bool.h"
 #include "./object.h"
+#include "./vm.h"
+#include "./jit.h"
+#include "./gc.h"
 
 #define LINE_BUFFER_SIZE 4096
 #define HISTORY_BUFFER_SIZE 20
@@ -39,6 +42,38 @@ int main(int argc, char** argv) {
     // Initialize rand
     srand(time(NULL) + clock());
 
+    // Parse options, the remaining arguments are the files to run
+    bool_t jit_stats = false;
+    bool_t gc_stats = false;
+    int num_args = 1;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--no-optimize") == 0)
+            program_set_optimize(false);
+        else if(strcmp(argv[i], "--optimize") == 0)
+            program_set_optimize(true);
+        else if(strcmp(argv[i], "--jit") == 0)
+            jit_set_enabled(true);
+        else if(strcmp(argv[i], "--no-jit") == 0)
+            jit_set_enabled(false);
+        else if(strcmp(argv[i], "--jit-stats") == 0)
+            jit_stats = true;
+        else if(strncmp(argv[i], "--gc-threshold=", 15) == 0)
+            gc_set_threshold(strtoul(argv[i] + 15, NULL, 10));
+        else if(strcmp(argv[i], "--gc-stats") == 0)
+            gc_stats = true;
+        else if(strcmp(argv[i], "--engine=bytecode") == 0)
+            vm_set_engine(VM_ENGINE_BYTECODE);
+        else if(strcmp(argv[i], "--engine=closure") == 0)
+            vm_set_engine(VM_ENGINE_CLOSURE);
+        else if(strcmp(argv[i], "--engine=tree") == 0)
+            vm_set_engine(VM_ENGINE_TREE);
+        else {
+            argv[num_args] = argv[i];
+            num_args++;
+        }
+    }
+    argc = num_args;
+
     // Create environment
     environment_t* env = environment_create();
     char* buffer;
@@ -141,6 +176,11 @@ int main(int argc, char** argv) {
         }
     }
     environment_free(env);
+    gc_collect();
+    if(jit_stats)
+        jit_print_stats();
+    if(gc_stats)
+        gc_print_stats();
 
     return error_flag;
 }
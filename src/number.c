@@ -1,15 +1,45 @@
 // Copyright (c) 2018-2019 Roland Bernard
 
 #include <math.h>
+#include <string.h>
+#include <stdio.h>
 
 #include "./number.h"
+#include "./prime.h"
 
-// TODO:
 id_t number_id(number_t num) {
-    if(num == round(num))
-        return (unsigned)(int)num; // Might still be undefined
+    if(num == 0)
+        return 0;
+    else if(fabs(num) < NUMBER_LONG_LIMIT && num == (long)num)
+        return hash_mix((unsigned long)(long)num);
+    else {
+        unsigned long bits;
+        memcpy(&bits, &num, sizeof(unsigned long));
+        return hash_mix(bits);
+    }
+}
+
+bool_t number_is_integer(number_t num) {
+    if(fabs(num) < NUMBER_LONG_LIMIT)
+        return num == (long)num;
+    else
+        return num == floor(num);
+}
+
+long number_to_long(number_t num) {
+    long ret = (long)num;
+    if(ret == num)
+        return ret;
+    else
+        return (long)round(num);
+}
+
+int number_to_cstr(char* str, number_t num) {
+    // Integers are printed directly, %.15g would print the same digits below 1e15
+    if(fabs(num) < 1e15 && num == (long)num && !(num == 0 && signbit(num)))
+        return sprintf(str, "%ld", (long)num);
     else
-        return *((id_t*)&num);
+        return sprintf(str, "%.15g", num);
 }
 
 int number_cmp(number_t n1, number_t n2) {
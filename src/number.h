@@ -6,10 +6,16 @@
 #include "./types.h"
 #include "./bool.h"
 
-// TODO: Upgrade number_t
-typedef long double number_t;
+// A double keeps integers exact up to 2^53 and avoids x87 arithmetic
+typedef double number_t;
+
+#define NUMBER_LONG_LIMIT 9e18
+#define NUMBER_STR_MAX 32
 
 id_t number_id(number_t num);
+bool_t number_is_integer(number_t num);
+long number_to_long(number_t num); // Rounds to the nearest integer
+int number_to_cstr(char* str, number_t num); // str must hold at least NUMBER_STR_MAX chars
 int number_cmp(number_t n1, number_t n2);
 bool_t number_equ(number_t n1, number_t n2);
 
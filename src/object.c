@@ -7,38 +7,59 @@
 #include "./langallocator.h"
 #include "./prime.h"
 #include "./error.h"
+#include "./gc.h"
 
 #define TMP_STR_MAX 1<<12
 
 bool_t empty_line = true;
 
+// None, booleans and small integers are shared and never freed, so creating them does not allocate
+#define OBJECT_IMMORTAL (((size_t)1) << (sizeof(size_t)*8 - 2))
+#define OBJECT_SMALL_NUMBER_MIN -128
+#define OBJECT_SMALL_NUMBER_MAX 1024
+
+static object_t object_none = { .num_references = OBJECT_IMMORTAL, .type = OBJECT_TYPE_NONE };
+static object_t object_true = { .num_references = OBJECT_IMMORTAL, .type = OBJECT_TYPE_BOOL, .data.boolean = true };
+static object_t object_false = { .num_references = OBJECT_IMMORTAL, .type = OBJECT_TYPE_BOOL, .data.boolean = false };
+static object_t object_small_numbers[OBJECT_SMALL_NUMBER_MAX - OBJECT_SMALL_NUMBER_MIN];
+
+static bool_t object_is_immortal(object_t* obj) {
+    return obj->num_references >= OBJECT_IMMORTAL / 2;
+}
+
 object_t* object_create_none() {
-    object_t* ret = (object_t*)_alloc(sizeof(object_t));
-    ret->num_references = 0;
-    ret->type = OBJECT_TYPE_NONE;
-    return ret;
+    return &object_none;
 }
 
 object_t* object_create_number(number_t number) {
+    if(number >= OBJECT_SMALL_NUMBER_MIN && number < OBJECT_SMALL_NUMBER_MAX && number == (long)number && !(number == 0 && signbit(number))) {
+        object_t* ret = &object_small_numbers[(long)number - OBJECT_SMALL_NUMBER_MIN];
+        if(ret->type != OBJECT_TYPE_NUMBER) {
+            ret->num_references = OBJECT_IMMORTAL;
+            ret->type = OBJECT_TYPE_NUMBER;
+            ret->data.number = number;
+        }
+        return ret;
+    }
     object_t* ret = (object_t*)_alloc(sizeof(object_t));
     ret->num_references = 0;
     ret->type = OBJECT_TYPE_NUMBER;
+    ret->gc_color = GC_COLOR_BLACK;
+    ret->gc_buffered = false;
     ret->data.number = number;
     return ret;
 }
 
 object_t* object_create_boolean(bool_t boolean) {
-    object_t* ret = (object_t*)_alloc(sizeof(object_t));
-    ret->num_references = 0;
-    ret->type = OBJECT_TYPE_BOOL;
-    ret->data.boolean = boolean;
-    return ret;
+    return boolean ? &object_true : &object_false;
 }
 
 object_t* object_create_string(string_t* string) {
     object_t* ret = (object_t*)_alloc(sizeof(object_t));
     ret->num_references = 0;
     ret->type = OBJECT_TYPE_STRING;
+    ret->gc_color = GC_COLOR_BLACK;
+    ret->gc_buffered = false;
     ret->data.string = string;
     return ret;
 }
@@ -47,6 +68,8 @@ object_t* object_create_pair(pair_t* pair) {
     object_t* ret = (object_t*)_alloc(sizeof(object_t));
     ret->num_references = 0;
     ret->type = OBJECT_TYPE_PAIR;
+    ret->gc_color = GC_COLOR_BLACK;
+    ret->gc_buffered = false;
     ret->data.pair = pair;
     return ret;
 }
@@ -55,6 +78,8 @@ object_t* object_create_list(list_t* list) {
     object_t* ret = (object_t*)_alloc(sizeof(object_t));
     ret->num_references = 0;
     ret->type = OBJECT_TYPE_LIST;
+    ret->gc_color = GC_COLOR_BLACK;
+    ret->gc_buffered = false;
     ret->data.list = list;
     return ret;
 }
@@ -63,6 +88,8 @@ object_t* object_create_dictionary(dictionary_t* dic) {
     object_t* ret = (object_t*)_alloc(sizeof(object_t));
     ret->num_references = 0;
     ret->type = OBJECT_TYPE_DICTIONARY;
+    ret->gc_color = GC_COLOR_BLACK;
+    ret->gc_buffered = false;
     ret->data.dic = dic;
     return ret;
 }
@@ -71,6 +98,8 @@ object_t* object_create_function(function_t* func) {
     object_t* ret = (object_t*)_alloc(sizeof(object_t));
     ret->num_references = 0;
     ret->type = OBJECT_TYPE_FUNCTION;
+    ret->gc_color = GC_COLOR_BLACK;
+    ret->gc_buffered = false;
     ret->data.func = func;
     return ret;
 }
@@ -79,6 +108,8 @@ object_t* object_create_macro(macro_t* mac) {
     object_t* ret = (object_t*)_alloc(sizeof(object_t));
     ret->num_references = 0;
     ret->type = OBJECT_TYPE_MACRO;
+    ret->gc_color = GC_COLOR_BLACK;
+    ret->gc_buffered = false;
     ret->data.mac = mac;
     return ret;
 }
@@ -87,6 +118,8 @@ object_t* object_create_struct(struct_t* stc) {
     object_t* ret = (object_t*)_alloc(sizeof(object_t));
     ret->num_references = 0;
     ret->type = OBJECT_TYPE_STRUCT;
+    ret->gc_color = GC_COLOR_BLACK;
+    ret->gc_buffered = false;
     ret->data.stc = stc;
     return ret;
 }
@@ -145,8 +178,14 @@ void object_reference(object_t* obj) {
 }
 
 bool_t object_dereference(object_t* obj) {
-    if(obj != NULL && obj != OBJECT_LIST_OPENED && obj->num_references > 0 )
+    if(obj != NULL && obj != OBJECT_LIST_OPENED && obj->num_references > 0 ) {
         obj->num_references--;
+        if(obj->num_references != 0 && object_is_container(obj)) {
+            // What is left of the references might only come from a cycle
+            gc_possible_root(obj);
+            return false;
+        }
+    }
     return object_check_reference(obj);
 }
 
@@ -158,9 +197,23 @@ bool_t object_check_reference(object_t* obj) {
     return false;
 }
 
-// TODO:
-void object_free(object_t* obj) {
-    if(obj != NULL && obj != OBJECT_LIST_OPENED && obj->type != OBJECT_TYPE_FREED) {
+bool_t object_is_container(object_t* obj) {
+    return obj->type == OBJECT_TYPE_LIST || obj->type == OBJECT_TYPE_DICTIONARY
+        || obj->type == OBJECT_TYPE_PAIR || obj->type == OBJECT_TYPE_STRUCT;
+}
+
+void object_visit_references(object_t* obj, object_visitor_t visit) {
+    switch(obj->type) {
+        case OBJECT_TYPE_PAIR: pair_visit(obj->data.pair, visit); break;
+        case OBJECT_TYPE_LIST: list_visit(obj->data.list, visit); break;
+        case OBJECT_TYPE_DICTIONARY: dictionary_visit(obj->data.dic, visit); break;
+        case OBJECT_TYPE_STRUCT: struct_visit(obj->data.stc, visit); break;
+        default: break;
+    }
+}
+
+void object_free_contents(object_t* obj) {
+    if(obj != NULL && obj != OBJECT_LIST_OPENED && obj->type != OBJECT_TYPE_FREED && !object_is_immortal(obj)) {
         object_type_t type = obj->type;
         obj->type = OBJECT_TYPE_FREED;
         switch(type)
@@ -177,7 +230,18 @@ void object_free(object_t* obj) {
             case OBJECT_TYPE_MACRO: macro_free(obj->data.mac); break;
             case OBJECT_TYPE_STRUCT: struct_free(obj->data.stc); break;
         }
-        _free(obj);
+    }
+}
+
+// TODO:
+void object_free(object_t* obj) {
+    if(obj != NULL && obj != OBJECT_LIST_OPENED && obj->type != OBJECT_TYPE_FREED && !object_is_immortal(obj)) {
+        gc_begin_free();
+        object_free_contents(obj);
+        // A buffered object is released by the collector once it gets to it
+        if(!obj->gc_buffered)
+            _free(obj);
+        gc_end_free();
     }
 }
 
@@ -189,7 +253,11 @@ void print_object(object_t* obj) {
         switch(obj->type) {
             case OBJECT_TYPE_FREED: break;
             case OBJECT_TYPE_NONE: fprintf(stdout, "none"); break;
-            case OBJECT_TYPE_NUMBER: fprintf(stdout, "%.15Lg", obj->data.number); break;
+            case OBJECT_TYPE_NUMBER: {
+                char temp_str[NUMBER_STR_MAX];
+                number_to_cstr(temp_str, obj->data.number);
+                fputs(temp_str, stdout);
+            } break;
             case OBJECT_TYPE_BOOL: fprintf(stdout, (obj->data.boolean ? "true" : "false")); break;
             case OBJECT_TYPE_STRING:
                 fprintf(stdout, "%s", string_get_cstr(obj->data.string));
@@ -225,21 +293,23 @@ void print_object(object_t* obj) {
             break;
             case OBJECT_TYPE_DICTIONARY:
                 fprintf(stdout, "dic(");
-                for(int i = 0; i < obj->data.dic->size; i++)
-                    if(obj->data.dic->data[i] != NULL) {
-                        if(obj->data.dic->data[i]->key->type == OBJECT_TYPE_STRING)
+                for(size_t i = 0; i < obj->data.dic->used; i++) {
+                    pair_t* entry = dictionary_entry(obj->data.dic, i);
+                    if(entry->key != NULL) {
+                        if(entry->key->type == OBJECT_TYPE_STRING)
                             fprintf(stdout, "\"");
-                        print_object(obj->data.dic->data[i]->key);
-                        if(obj->data.dic->data[i]->key->type == OBJECT_TYPE_STRING)
+                        print_object(entry->key);
+                        if(entry->key->type == OBJECT_TYPE_STRING)
                             fprintf(stdout, "\"");
                         fprintf(stdout, ":");
-                        if(obj->data.dic->data[i]->value->type == OBJECT_TYPE_STRING)
+                        if(entry->value->type == OBJECT_TYPE_STRING)
                             fprintf(stdout, "\"");
-                        print_object(obj->data.dic->data[i]->value);
-                        if(obj->data.dic->data[i]->value->type == OBJECT_TYPE_STRING)
+                        print_object(entry->value);
+                        if(entry->value->type == OBJECT_TYPE_STRING)
                             fprintf(stdout, "\"");
                         fprintf(stdout, ",");
                     }
+                }
                 fprintf(stdout, ")");
                 empty_line = false;
             break;
@@ -250,51 +320,63 @@ void print_object(object_t* obj) {
     }
 }
 
-string_t* object_to_string(object_t* obj) {
-    string_t* ret = NULL;
-    if(obj == NULL || obj == OBJECT_LIST_OPENED)
-        ret = string_create("null");
+static void object_append_to_string(string_t* str, object_t* obj) {
+    if(obj == NULL || obj == OBJECT_LIST_OPENED) {
+        string_append_cstr(str, "null", 4);
+        return;
+    }
     switch (obj->type) {
         case OBJECT_TYPE_FREED: break;
-        case OBJECT_TYPE_NONE: ret = string_create("none"); break;
+        case OBJECT_TYPE_NONE: string_append_cstr(str, "none", 4); break;
         case OBJECT_TYPE_NUMBER: {
-            char temp_str[TMP_STR_MAX];
-            sprintf(temp_str, "%.15Lg", obj->data.number);
-            ret = string_create(temp_str);
+            char temp_str[NUMBER_STR_MAX];
+            string_append_cstr(str, temp_str, number_to_cstr(temp_str, obj->data.number));
         } break;
-        case OBJECT_TYPE_BOOL: ret = string_create(obj->data.boolean ? "true" : "false"); break;
-        case OBJECT_TYPE_STRING: ret = string_copy(obj->data.string); break;
+        case OBJECT_TYPE_BOOL:
+            if(obj->data.boolean)
+                string_append_cstr(str, "true", 4);
+            else
+                string_append_cstr(str, "false", 5);
+        break;
+        case OBJECT_TYPE_STRING: string_append(str, obj->data.string); break;
         case OBJECT_TYPE_LIST:
-            ret = string_create("");
-            ret = string_concat_and_free(ret, string_create("["));
+            string_append_cstr(str, "[", 1);
             for(int i = 0; i < obj->data.list->size; i++) {
-                ret = string_concat_and_free(ret, object_to_string(obj->data.list->data[i]));
-                ret = string_concat_and_free(ret, string_create(","));
+                object_append_to_string(str, obj->data.list->data[i]);
+                string_append_cstr(str, ",", 1);
             }
-            ret = string_concat_and_free(ret, string_create("]"));
+            string_append_cstr(str, "]", 1);
         break;
         case OBJECT_TYPE_PAIR:
-            ret = string_create("");
-            ret = string_concat_and_free(ret, object_to_string(obj->data.pair->key));
-            ret = string_concat_and_free(ret, string_create(":"));
-            ret = string_concat_and_free(ret, object_to_string(obj->data.pair->value));
+            object_append_to_string(str, obj->data.pair->key);
+            string_append_cstr(str, ":", 1);
+            object_append_to_string(str, obj->data.pair->value);
         break;
         case OBJECT_TYPE_DICTIONARY:
-            ret = string_create("");
-            ret = string_concat_and_free(ret, string_create("dic("));
-            for(int i = 0; i < obj->data.dic->size; i++)
-                if(obj->data.dic->data[i] != NULL) {
-                    ret = string_concat_and_free(ret, object_to_string(obj->data.dic->data[i]->key));
-                    ret = string_concat_and_free(ret, string_create(":"));
-                    ret = string_concat_and_free(ret, object_to_string(obj->data.dic->data[i]->value));
-                    ret = string_concat_and_free(ret, string_create(","));
+            string_append_cstr(str, "dic(", 4);
+            for(size_t i = 0; i < obj->data.dic->used; i++) {
+                pair_t* entry = dictionary_entry(obj->data.dic, i);
+                if(entry->key != NULL) {
+                    object_append_to_string(str, entry->key);
+                    string_append_cstr(str, ":", 1);
+                    object_append_to_string(str, entry->value);
+                    string_append_cstr(str, ",", 1);
                 }
-            ret = string_concat_and_free(ret, string_create(")"));
+            }
+            string_append_cstr(str, ")", 1);
         break;
-        case OBJECT_TYPE_FUNCTION: ret = string_create("/function/"); break;
-        case OBJECT_TYPE_MACRO: ret = string_create("/macro/"); break;
-        case OBJECT_TYPE_STRUCT: ret = string_create("/struct/"); break;
+        case OBJECT_TYPE_FUNCTION: string_append_cstr(str, "/function/", 10); break;
+        case OBJECT_TYPE_MACRO: string_append_cstr(str, "/macro/", 7); break;
+        case OBJECT_TYPE_STRUCT: string_append_cstr(str, "/struct/", 8); break;
     }
+}
+
+// The rendering is appended into one growing buffer, so nested lists do not copy their text repeatedly
+string_t* object_to_string(object_t* obj) {
+    if(obj != NULL && obj != OBJECT_LIST_OPENED && obj->type == OBJECT_TYPE_STRING)
+        return string_copy(obj->data.string);
+    string_t* ret = string_create_sized(16);
+    object_append_to_string(ret, obj);
     return ret;
 }
 
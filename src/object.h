@@ -34,6 +34,8 @@ typedef enum object_type_e {
 typedef struct object_s {
     size_t num_references;
     object_type_t type;
+    unsigned char gc_color;    // State of the object in the cycle collector, see gc.h
+    bool_t gc_buffered;        // The object is a possible cycle root buffered by the collector
     union
     {
         number_t number;
@@ -68,6 +70,9 @@ bool_t object_equ(object_t* o1, object_t* o2);
 void object_reference(object_t* obj);
 bool_t object_dereference(object_t* obj);
 bool_t object_check_reference(object_t* obj);
+bool_t object_is_container(object_t* obj); // Lists, dictionaries, pairs and structs, the objects that can form cycles
+void object_visit_references(object_t* obj, object_visitor_t visit); // Calls visit for every object obj references
+void object_free_contents(object_t* obj); // Frees what obj holds and marks it as freed, but not obj itself
 void object_free(object_t* obj);
 void print_object(object_t* obj);
 string_t* object_to_string(object_t* obj);
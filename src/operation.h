@@ -8,6 +8,7 @@
 #include "./bool.h"
 #include "./string.h"
 #include "./environment.h"
+#include "./result.h"
 
 #define RET_ERROR ((void*)0x01)
 #define OBJECT_LIST_OPENED ((void*)0x02)
@@ -101,8 +102,22 @@ typedef enum operation_type_e {
     OPERATION_TYPE_FWRITE,           // fwrite ( EXP )
 } operation_type_t;
 
+struct bytecode_s;
+struct closure_s;
+struct jit_s;
+
 typedef struct operation_s {
     operation_type_t type;
+    size_t num_references;     // References held by functions and macros besides the owning tree
+    struct bytecode_s* exec_code;
+    struct bytecode_s* result_code;
+    struct closure_s* exec_closure;
+    struct closure_s* result_closure;
+    struct closure_s* body_closure;    // Result closure of a function body, calls in tail position are left to its caller
+    struct jit_s* jit;             // Machine code for a loop or function body
+    object_t* constant;        // Prebuilt value of a NUM or STR literal, set by the optimizer
+    shape_t* cache_shape;      // Inline cache of a VAR looked up in the members of a struct
+    long cache_slot;
     union operation_data_u {
         number_t num;
         bool_t boolean;
@@ -111,12 +126,24 @@ typedef struct operation_s {
     } data;
 } operation_t;
 
+typedef enum operation_demand_e {
+    OPERATION_DEMAND_DISCARD,    // Only the side effects, returns NULL or RET_ERROR
+    OPERATION_DEMAND_VALUE,        // The values are written to res, returns res->values
+    OPERATION_DEMAND_LOCATION,    // Returns the locations as object_t***
+} operation_demand_t;
+
 operation_t* operation_create();
 operation_t* operation_create_NOOP();
+void* operation_eval(operation_t* op, environment_t* env, operation_demand_t demand, result_t* res);
 void* operation_exec(operation_t* op, environment_t* env);
 object_t** operation_result(operation_t* op, environment_t* env);
+void operation_result_into(operation_t* op, environment_t* env, result_t* res);
 object_t*** operation_var(operation_t* op, environment_t* env);
-void operation_free(operation_t* op);
+// Evaluates a function body, a call in tail position is not made but returned in tail_func and tail_par, which the caller owns
+object_t** operation_result_body(operation_t* op, environment_t* env, object_t** tail_func, object_t*** tail_par);
+object_t** operation_index(object_t** data, object_t** index);
+void operation_reference(operation_t* op);
+void operation_free(operation_t* op); // Drops one reference, the tree is only freed if there are none left
 id_t operation_id(operation_t* op);
 bool_t operation_equ(operation_t* o1, operation_t* o2);
 operation_t* operation_copy(operation_t* op);
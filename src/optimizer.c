@@ -0,0 +1,368 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#include "./optimizer.h"
+#include "./object.h"
+#include "./environment.h"
+#include "./langallocator.h"
+#include "./error.h"
+
+static environment_t* optimizer_env = NULL;
+static bool_t optimizer_error_flag = false;
+
+static void optimizer_error_handler(const char* msg) {
+    optimizer_error_flag = true;
+}
+
+static size_t optimizer_num_operands(operation_t* op) {
+    switch(op->type) {
+        case OPERATION_TYPE_PROC:
+        case OPERATION_TYPE_PROC_IMP:
+        case OPERATION_TYPE_O_LIST:
+        case OPERATION_TYPE_ADD:
+        case OPERATION_TYPE_SUB:
+        case OPERATION_TYPE_MUL:
+        case OPERATION_TYPE_DIV:
+        case OPERATION_TYPE_MOD:
+        case OPERATION_TYPE_POW:
+        case OPERATION_TYPE_AND:
+        case OPERATION_TYPE_OR:
+        case OPERATION_TYPE_XOR: {
+            size_t num_op = 0;
+            while(op->data.operations[num_op] != NULL)
+                num_op++;
+            return num_op;
+        }
+        case OPERATION_TYPE_EXEC:
+        case OPERATION_TYPE_INDEX:
+        case OPERATION_TYPE_IN_STRUCT:
+        case OPERATION_TYPE_PAIR:
+        case OPERATION_TYPE_ASSIGN:
+        case OPERATION_TYPE_EQU:
+        case OPERATION_TYPE_GTR:
+        case OPERATION_TYPE_LES:
+        case OPERATION_TYPE_LEQ:
+        case OPERATION_TYPE_GEQ:
+        case OPERATION_TYPE_FIND:
+        case OPERATION_TYPE_FUNCTION:
+        case OPERATION_TYPE_SPLIT:
+        case OPERATION_TYPE_IF:
+        case OPERATION_TYPE_WHILE:
+            return 2;
+        case OPERATION_TYPE_IFELSE:
+        case OPERATION_TYPE_FOR_IN:
+            return 3;
+        case OPERATION_TYPE_FOR:
+            return 4;
+        case OPERATION_TYPE_LIST:
+        case OPERATION_TYPE_SCOPE:
+        case OPERATION_TYPE_ABS:
+        case OPERATION_TYPE_MACRO:
+        case OPERATION_TYPE_STRUCT:
+        case OPERATION_TYPE_DIC:
+        case OPERATION_TYPE_SIN:
+        case OPERATION_TYPE_COS:
+        case OPERATION_TYPE_TAN:
+        case OPERATION_TYPE_ASIN:
+        case OPERATION_TYPE_ACOS:
+        case OPERATION_TYPE_ATAN:
+        case OPERATION_TYPE_SINH:
+        case OPERATION_TYPE_COSH:
+        case OPERATION_TYPE_TANH:
+        case OPERATION_TYPE_ASINH:
+        case OPERATION_TYPE_ACOSH:
+        case OPERATION_TYPE_ATANH:
+        case OPERATION_TYPE_TRUNC:
+        case OPERATION_TYPE_FLOOR:
+        case OPERATION_TYPE_CEIL:
+        case OPERATION_TYPE_ROUND:
+        case OPERATION_TYPE_LEN:
+        case OPERATION_TYPE_CBRT:
+        case OPERATION_TYPE_SQRT:
+        case OPERATION_TYPE_TO_STR:
+        case OPERATION_TYPE_TO_NUM:
+        case OPERATION_TYPE_TO_BOOL:
+        case OPERATION_TYPE_TO_ASCII:
+        case OPERATION_TYPE_WRITE:
+        case OPERATION_TYPE_NEG:
+        case OPERATION_TYPE_NOT:
+        case OPERATION_TYPE_LOCAL:
+        case OPERATION_TYPE_GLOBAL:
+        case OPERATION_TYPE_COPY:
+        case OPERATION_TYPE_IMPORT:
+        case OPERATION_TYPE_FOPEN:
+        case OPERATION_TYPE_FCLOSE:
+        case OPERATION_TYPE_FREAD:
+        case OPERATION_TYPE_FWRITE:
+        case OPERATION_TYPE_LIST_OPEN:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Operations whose result only depends on the values of their operands
+static bool_t optimizer_is_pure(operation_type_t type) {
+    switch(type) {
+        case OPERATION_TYPE_ADD:
+        case OPERATION_TYPE_SUB:
+        case OPERATION_TYPE_MUL:
+        case OPERATION_TYPE_DIV:
+        case OPERATION_TYPE_MOD:
+        case OPERATION_TYPE_POW:
+        case OPERATION_TYPE_NEG:
+        case OPERATION_TYPE_AND:
+        case OPERATION_TYPE_OR:
+        case OPERATION_TYPE_XOR:
+        case OPERATION_TYPE_NOT:
+        case OPERATION_TYPE_EQU:
+        case OPERATION_TYPE_GTR:
+        case OPERATION_TYPE_LES:
+        case OPERATION_TYPE_LEQ:
+        case OPERATION_TYPE_GEQ:
+        case OPERATION_TYPE_FIND:
+        case OPERATION_TYPE_ABS:
+        case OPERATION_TYPE_SIN:
+        case OPERATION_TYPE_COS:
+        case OPERATION_TYPE_TAN:
+        case OPERATION_TYPE_ASIN:
+        case OPERATION_TYPE_ACOS:
+        case OPERATION_TYPE_ATAN:
+        case OPERATION_TYPE_SINH:
+        case OPERATION_TYPE_COSH:
+        case OPERATION_TYPE_TANH:
+        case OPERATION_TYPE_ASINH:
+        case OPERATION_TYPE_ACOSH:
+        case OPERATION_TYPE_ATANH:
+        case OPERATION_TYPE_TRUNC:
+        case OPERATION_TYPE_FLOOR:
+        case OPERATION_TYPE_CEIL:
+        case OPERATION_TYPE_ROUND:
+        case OPERATION_TYPE_LEN:
+        case OPERATION_TYPE_CBRT:
+        case OPERATION_TYPE_SQRT:
+        case OPERATION_TYPE_TO_STR:
+        case OPERATION_TYPE_TO_NUM:
+        case OPERATION_TYPE_TO_BOOL:
+        case OPERATION_TYPE_TO_ASCII:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool_t optimizer_is_literal(operation_t* op) {
+    return op != NULL && (op->type == OPERATION_TYPE_NUM || op->type == OPERATION_TYPE_STR
+        || op->type == OPERATION_TYPE_BOOL || op->type == OPERATION_TYPE_NONE);
+}
+
+// Whether op can be applied to its first num_op operands, which are literals, without an error.
+// Operations that would fail are not folded, their error is reported if they are ever run.
+static bool_t optimizer_types_fit(operation_t* op, size_t num_op) {
+    bool_t numbers = true;
+    bool_t bools = true;
+    bool_t strings = true;
+    for(int i = 0; i < num_op; i++) {
+        operation_type_t type = op->data.operations[i]->type;
+        numbers = numbers && type == OPERATION_TYPE_NUM;
+        bools = bools && type == OPERATION_TYPE_BOOL;
+        strings = strings && type == OPERATION_TYPE_STR;
+    }
+    switch(op->type) {
+        case OPERATION_TYPE_EQU:
+            return true;
+        case OPERATION_TYPE_ADD:
+            return numbers || strings;
+        case OPERATION_TYPE_AND:
+        case OPERATION_TYPE_OR:
+        case OPERATION_TYPE_XOR:
+            return numbers || bools;
+        case OPERATION_TYPE_NOT:
+            return bools;
+        case OPERATION_TYPE_LEN:
+            return strings;
+        case OPERATION_TYPE_TO_STR:
+        case OPERATION_TYPE_TO_NUM:
+        case OPERATION_TYPE_TO_BOOL:
+            return numbers || bools || strings;
+        case OPERATION_TYPE_SUB:
+        case OPERATION_TYPE_MUL:
+        case OPERATION_TYPE_DIV:
+        case OPERATION_TYPE_MOD:
+        case OPERATION_TYPE_POW:
+        case OPERATION_TYPE_NEG:
+        case OPERATION_TYPE_GTR:
+        case OPERATION_TYPE_LES:
+        case OPERATION_TYPE_LEQ:
+        case OPERATION_TYPE_GEQ:
+        case OPERATION_TYPE_ABS:
+        case OPERATION_TYPE_SIN:
+        case OPERATION_TYPE_COS:
+        case OPERATION_TYPE_TAN:
+        case OPERATION_TYPE_ASIN:
+        case OPERATION_TYPE_ACOS:
+        case OPERATION_TYPE_ATAN:
+        case OPERATION_TYPE_SINH:
+        case OPERATION_TYPE_COSH:
+        case OPERATION_TYPE_TANH:
+        case OPERATION_TYPE_ASINH:
+        case OPERATION_TYPE_ACOSH:
+        case OPERATION_TYPE_ATANH:
+        case OPERATION_TYPE_TRUNC:
+        case OPERATION_TYPE_FLOOR:
+        case OPERATION_TYPE_CEIL:
+        case OPERATION_TYPE_ROUND:
+        case OPERATION_TYPE_CBRT:
+        case OPERATION_TYPE_SQRT:
+            return numbers;
+        default:
+            return false;
+    }
+}
+
+static bool_t optimizer_literal_is_true(operation_t* op) {
+    switch(op->type) {
+        case OPERATION_TYPE_NUM: return op->data.num != 0;
+        case OPERATION_TYPE_STR: return string_length(op->data.str) != 0;
+        case OPERATION_TYPE_BOOL: return op->data.boolean;
+        default: return false;
+    }
+}
+
+static operation_t* optimizer_literal(object_t* obj) {
+    operation_t* ret = NULL;
+    switch(obj->type) {
+        case OBJECT_TYPE_NONE:
+            ret = operation_create();
+            ret->type = OPERATION_TYPE_NONE;
+            break;
+        case OBJECT_TYPE_NUMBER:
+            ret = operation_create();
+            ret->type = OPERATION_TYPE_NUM;
+            ret->data.num = obj->data.number;
+            break;
+        case OBJECT_TYPE_BOOL:
+            ret = operation_create();
+            ret->type = OPERATION_TYPE_BOOL;
+            ret->data.boolean = obj->data.boolean;
+            break;
+        case OBJECT_TYPE_STRING:
+            ret = operation_create();
+            ret->type = OPERATION_TYPE_STR;
+            ret->data.str = string_copy(obj->data.string);
+            break;
+        default: break;
+    }
+    return ret;
+}
+
+// Evaluates op with the tree walker and returns a literal for its value, or NULL if
+// it does not evaluate to a single scalar. Errors are left to be reported at runtime.
+static operation_t* optimizer_evaluate(operation_t* op) {
+    if(optimizer_env == NULL)
+        optimizer_env = environment_create();
+    error_handler_t old_handler = get_error_handler();
+    optimizer_error_flag = false;
+    set_error_handler(optimizer_error_handler);
+    result_t result;
+    operation_result_into(op, optimizer_env, &result);
+    set_error_handler(old_handler);
+
+    operation_t* ret = NULL;
+    if(!optimizer_error_flag && result.values != NULL && result.values != RET_ERROR
+        && result.length == 1 && result.values[0] != OBJECT_LIST_OPENED)
+        ret = optimizer_literal(result.values[0]);
+    result_release(&result);
+    return ret;
+}
+
+// Moves the contents of with into op and frees whatever op held before
+static void optimizer_replace(operation_t* op, operation_t* with) {
+    operation_t tmp = *op;
+    *op = *with;
+    *with = tmp;
+    operation_free(with);
+}
+
+static void optimizer_optimize(operation_t* op);
+
+static void optimizer_fold(operation_t* op) {
+    size_t num_op = optimizer_num_operands(op);
+    size_t num_literal = 0;
+    while(num_literal < num_op && optimizer_is_literal(op->data.operations[num_literal]))
+        num_literal++;
+
+    if(num_literal == num_op) {
+        if(!optimizer_types_fit(op, num_op))
+            return;
+        operation_t* lit = optimizer_evaluate(op);
+        if(lit != NULL)
+            optimizer_replace(op, lit);
+    } else if(num_literal >= 2 && (op->type == OPERATION_TYPE_ADD || op->type == OPERATION_TYPE_SUB
+        || op->type == OPERATION_TYPE_MUL || op->type == OPERATION_TYPE_DIV || op->type == OPERATION_TYPE_MOD)) {
+        // These are evaluated from left to right, so a constant prefix can be combined on its own
+        operation_t* prefix = operation_create();
+        prefix->type = op->type;
+        prefix->data.operations = (operation_t**)_alloc(sizeof(operation_t*)*(num_literal+1));
+        for(int i = 0; i < num_literal; i++)
+            prefix->data.operations[i] = op->data.operations[i];
+        prefix->data.operations[num_literal] = NULL;
+
+        operation_t* lit = optimizer_types_fit(prefix, num_literal) ? optimizer_evaluate(prefix) : NULL;
+        if(lit != NULL) {
+            operation_free(prefix);
+            optimizer_optimize(lit);
+            op->data.operations[0] = lit;
+            for(int i = 1; i + num_literal - 1 <= num_op; i++)
+                op->data.operations[i] = op->data.operations[i + num_literal - 1];
+        } else {
+            _free(prefix->data.operations);
+            prefix->type = OPERATION_TYPE_NOOP;
+            operation_free(prefix);
+        }
+    }
+}
+
+static void optimizer_optimize(operation_t* op) {
+    if(op == NULL)
+        return;
+
+    size_t num_op = optimizer_num_operands(op);
+    for(int i = 0; i < num_op; i++) {
+        // Assignment targets and loop variables are locations, not values
+        if(i == 0 && (op->type == OPERATION_TYPE_ASSIGN || op->type == OPERATION_TYPE_FOR_IN))
+            continue;
+        optimizer_optimize(op->data.operations[i]);
+    }
+
+    if(optimizer_is_pure(op->type))
+        optimizer_fold(op);
+    else if((op->type == OPERATION_TYPE_IF || op->type == OPERATION_TYPE_IFELSE)
+        && optimizer_is_literal(op->data.operations[0])) {
+        operation_t* branch;
+        if(optimizer_literal_is_true(op->data.operations[0])) {
+            branch = op->data.operations[1];
+            op->data.operations[1] = NULL;
+        } else if(op->type == OPERATION_TYPE_IFELSE) {
+            branch = op->data.operations[2];
+            op->data.operations[2] = NULL;
+        } else
+            branch = operation_create_NOOP();
+        optimizer_replace(op, branch);
+    }
+
+    if(op->type == OPERATION_TYPE_NUM && op->constant == NULL) {
+        op->constant = object_create_number(op->data.num);
+        object_reference(op->constant);
+    } else if(op->type == OPERATION_TYPE_STR && op->constant == NULL) {
+        op->constant = object_create_string(string_copy(op->data.str));
+        object_reference(op->constant);
+    }
+}
+
+void optimizer_run(operation_t* op) {
+    optimizer_optimize(op);
+    if(optimizer_env != NULL) {
+        environment_free(optimizer_env);
+        optimizer_env = NULL;
+    }
+}
@@ -0,0 +1,13 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#ifndef __OPTIMIZER_H__
+#define __OPTIMIZER_H__
+
+#include "./types.h"
+#include "./operation.h"
+
+// Simplifies a freshly parsed tree in place: folds constant subexpressions, prunes
+// if branches with constant conditions and prebuilds the values of literals.
+void optimizer_run(operation_t* op);
+
+#endif
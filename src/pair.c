@@ -43,6 +43,13 @@ bool_t pair_equ(pair_t* p1, pair_t* p2) {
         return p1 == p2;
 }
 
+void pair_visit(pair_t* pair, object_visitor_t visit) {
+    if(pair != NULL) {
+        visit(pair->key);
+        visit(pair->value);
+    }
+}
+
 void pair_free(pair_t* pair) {
     if(pair != NULL) {
         object_dereference(pair->key);
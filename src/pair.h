@@ -15,6 +15,7 @@ pair_t* pair_create(object_t* k, object_t* v);
 pair_t* pair_copy(pair_t* pair);
 id_t pair_id(pair_t* pair);
 bool_t pair_equ(pair_t* p1, pair_t* p2);
+void pair_visit(pair_t* pair, object_visitor_t visit);
 void pair_free(pair_t* pair);
 
 #endif
\ No newline at end of file
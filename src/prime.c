@@ -21,4 +21,18 @@ unsigned int next_prime(unsigned int x) {
         x++;
     }
     return x;
-}
\ No newline at end of file
+}
+
+// Finalizer of splitmix64, folded to 32 bits
+unsigned int hash_mix(unsigned long x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9UL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebUL;
+    x ^= x >> 31;
+    return (unsigned int)(x ^ (x >> 32));
+}
+
+unsigned int hash_combine(unsigned int seed, unsigned int value) {
+    return hash_mix(((unsigned long)seed << 32) | value);
+}
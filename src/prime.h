@@ -49,4 +49,7 @@
 
 
 unsigned int is_prime(const unsigned int x);
-unsigned int next_prime(unsigned int x);
\ No newline at end of file
+unsigned int next_prime(unsigned int x);
+
+unsigned int hash_mix(unsigned long x);
+unsigned int hash_combine(unsigned int seed, unsigned int value);
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "./langallocator.h"
 #include "./error.h"
 #include "./types.h"
+#include "./vm.h"
+#include "./optimizer.h"
 
 #define MAX_STACK_SIZE 1<<10
 
@@ -697,10 +699,18 @@ program_t* parse_program(tokenlist_t* list) {
         return NULL;
 }
 
+static bool_t program_optimize = true;
+
+void program_set_optimize(bool_t optimize) {
+    program_optimize = optimize;
+}
+
 program_t* tokenize_and_parse_program(const char* src) {
     tokenlist_t* tokens = tokenize(src);
     program_t* program = parse_program(tokens);
     _free(tokens);
+    if(program != NULL && program_optimize)
+        optimizer_run(program);
     return program;
 }
 
@@ -709,10 +719,10 @@ void program_free(program_t* program) {
 }
 
 void program_exec(program_t* program, environment_t* env) {
-    operation_exec(program, env);
+    vm_exec(program, env);
 }
 
 object_t** program_result(program_t* program, environment_t* env) {
-    return operation_result(program, env);
+    return vm_result(program, env);
 }
 
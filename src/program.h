@@ -10,6 +10,7 @@
 typedef    operation_t program_t;
 
 program_t* parse_program(tokenlist_t* tokens);
+void program_set_optimize(bool_t optimize); // Whether tokenize_and_parse_program runs the optimizer, on by default
 program_t* tokenize_and_parse_program(const char* src);
 void program_free(program_t* program);
 void program_exec(program_t* program, environment_t* env);
@@ -0,0 +1,53 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#include <string.h>
+
+#include "./result.h"
+#include "./object.h"
+#include "./operation.h"
+#include "./langallocator.h"
+
+object_t** result_alloc(result_t* res, size_t length) {
+    if(length <= RESULT_INLINE_SIZE)
+        return res->inline_values;
+    else
+        return (object_t**)_alloc(sizeof(object_t*)*(length+1));
+}
+
+void result_set(result_t* res, object_t** values) {
+    res->values = values;
+    res->length = 0;
+    if(values != NULL && values != RET_ERROR)
+        while(values[res->length] != NULL)
+            res->length++;
+}
+
+void result_discard(result_t* res, object_t** values) {
+    if(values != res->inline_values)
+        _free(values);
+}
+
+object_t** result_take(result_t* res) {
+    object_t** ret = res->values;
+    if(ret == res->inline_values) {
+        ret = (object_t**)_alloc(sizeof(object_t*)*(res->length+1));
+        memcpy(ret, res->inline_values, sizeof(object_t*)*(res->length+1));
+    }
+    res->values = NULL;
+    res->length = 0;
+    return ret;
+}
+
+void result_free(result_t* res) {
+    if(res->values != NULL && res->values != RET_ERROR && res->values != res->inline_values)
+        _free(res->values);
+    res->values = NULL;
+    res->length = 0;
+}
+
+void result_release(result_t* res) {
+    if(res->values != NULL && res->values != RET_ERROR)
+        for(size_t i = 0; i < res->length; i++)
+            object_dereference(res->values[i]);
+    result_free(res);
+}
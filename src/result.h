@@ -0,0 +1,30 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#ifndef __RESULT_H__
+#define __RESULT_H__
+
+#include "./types.h"
+
+// Results with up to this many values are stored in the result itself
+#define RESULT_INLINE_SIZE 4
+
+typedef struct result_s {
+    object_t** values;    // NULL, RET_ERROR or length values followed by NULL
+    size_t length;
+    object_t* inline_values[RESULT_INLINE_SIZE+1];
+} result_t;
+
+// Returns storage for length values and the terminating NULL, not yet owned by res
+object_t** result_alloc(result_t* res, size_t length);
+// values is NULL, RET_ERROR, storage from result_alloc or an array allocated with _alloc
+void result_set(result_t* res, object_t** values);
+// Frees storage returned by result_alloc that was not given to result_set
+void result_discard(result_t* res, object_t** values);
+// Returns the values in an array allocated with _alloc and leaves res empty
+object_t** result_take(result_t* res);
+// Frees the storage, but not the values
+void result_free(result_t* res);
+// Dereferences the values and frees the storage
+void result_release(result_t* res);
+
+#endif
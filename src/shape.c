@@ -0,0 +1,65 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#include "./shape.h"
+#include "./prime.h"
+#include "./langallocator.h"
+
+static shape_t* shape_root_shape = NULL;
+
+static shape_t* shape_create(string_t** names, size_t count) {
+    shape_t* ret = (shape_t*)_alloc(sizeof(shape_t));
+
+    ret->names = names;
+    ret->count = count;
+    ret->index_size = next_prime(2*count + 1);
+    ret->index = (long*)_alloc(sizeof(long)*ret->index_size);
+    for(size_t i = 0; i < ret->index_size; i++)
+        ret->index[i] = -1;
+    for(size_t i = 0; i < count; i++) {
+        size_t pos = string_id(names[i]) % ret->index_size;
+        while(ret->index[pos] != -1)
+            pos = (pos + 1) % ret->index_size;
+        ret->index[pos] = i;
+    }
+    ret->transitions = NULL;
+    ret->num_transitions = 0;
+    ret->transitions_size = 0;
+
+    return ret;
+}
+
+shape_t* shape_root() {
+    if(shape_root_shape == NULL)
+        shape_root_shape = shape_create(NULL, 0);
+    return shape_root_shape;
+}
+
+long shape_find(shape_t* shape, string_t* name) {
+    size_t pos = string_id(name) % shape->index_size;
+    while(shape->index[pos] != -1) {
+        if(string_equ(shape->names[shape->index[pos]], name))
+            return shape->index[pos];
+        pos = (pos + 1) % shape->index_size;
+    }
+    return -1;
+}
+
+shape_t* shape_add(shape_t* shape, string_t* name) {
+    for(size_t i = 0; i < shape->num_transitions; i++)
+        if(string_equ(shape->transitions[i]->names[shape->count], name))
+            return shape->transitions[i];
+
+    string_t** names = (string_t**)_alloc(sizeof(string_t*)*(shape->count+1));
+    for(size_t i = 0; i < shape->count; i++)
+        names[i] = shape->names[i];
+    names[shape->count] = string_copy(name);
+    shape_t* ret = shape_create(names, shape->count+1);
+
+    if(shape->num_transitions == shape->transitions_size) {
+        shape->transitions_size = shape->transitions_size == 0 ? 2 : shape->transitions_size*2;
+        shape->transitions = (shape_t**)_realloc(shape->transitions, sizeof(shape_t*)*shape->transitions_size);
+    }
+    shape->transitions[shape->num_transitions++] = ret;
+
+    return ret;
+}
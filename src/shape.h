@@ -0,0 +1,26 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#ifndef __SHAPE_H__
+#define __SHAPE_H__
+
+#include "./types.h"
+#include "./string.h"
+
+// Layout of the members of a struct. Structs that got the same members in the same order
+// share one shape, their values are kept in slots in the order the members were added.
+// Shapes are never freed.
+typedef struct shape_s {
+    string_t** names;    // Name of every slot
+    size_t count;
+    long* index;        // Open addressing table from name to slot, -1 marks empty entries
+    size_t index_size;
+    struct shape_s** transitions;    // Already created shapes with one more member
+    size_t num_transitions;
+    size_t transitions_size;
+} shape_t;
+
+shape_t* shape_root(); // The shape without members
+long shape_find(shape_t* shape, string_t* name); // Returns the slot of name or -1
+shape_t* shape_add(shape_t* shape, string_t* name); // Shape with name added as the last slot
+
+#endif
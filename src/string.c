@@ -2,6 +2,7 @@
 
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 
 #include "./prime.h"
 #include "./string.h"
@@ -24,51 +25,77 @@ string_t* string_create_full(const char* str, size_t length) {
 
     ret->data = (char*)_alloc((sizeof(char)*length + 1));
     ret->length = length;
-    while(length) {
-        length--;
-        ret->data[length] = str[length];
-    }
+    ret->capacity = length + 1;
+    if(length > 0)
+        memcpy(ret->data, str, length);
     ret->data[ret->length] = 0;
+    ret->id = 0;
+    ret->num_references = 0;
 
     return ret;
 }
 
-string_t* string_copy(string_t* str) {
-    string_t* ret = NULL;
+string_t* string_create_sized(size_t capacity) {
+    string_t* ret = (string_t*)_alloc(sizeof(string_t));
 
-    if(str != NULL) {
-        ret = (string_t*)_alloc(sizeof(string_t));
-        ret->data = (char*)_alloc(sizeof(char)*(str->length + 1));
-        for(ret->length = 0; ret->length < str->length; ret->length++)
-            ret->data[ret->length] = str->data[ret->length];
-        ret->data[ret->length] = 0;
-    }
+    if(capacity < 1)
+        capacity = 1;
+    ret->data = (char*)_alloc(sizeof(char)*capacity);
+    ret->data[0] = 0;
+    ret->length = 0;
+    ret->capacity = capacity;
+    ret->id = 0;
+    ret->num_references = 0;
 
     return ret;
 }
 
+// Shared strings are never changed, so a copy can share the original
+string_t* string_copy(string_t* str) {
+    if(str != NULL)
+        str->num_references++;
+    return str;
+}
+
 string_t* string_concat(string_t* s1, string_t* s2) {
     string_t* ret = NULL;
     
     if(s1 != NULL && s2 != NULL) {
         ret = (string_t*)_alloc(sizeof(string_t));
         ret->data = (char*)_alloc(sizeof(char)*(s1->length + s2->length + 1));
-        ret->length = 0;
-        while(ret->length < s1->length) {
-            ret->data[ret->length] = s1->data[ret->length];
-            ret->length++;
-        }
-
-        while(ret->length < s1->length + s2->length) {
-            ret->data[ret->length] = s2->data[ret->length - s1->length];
-            ret->length++;
-        }
+        ret->length = s1->length + s2->length;
+        ret->capacity = ret->length + 1;
+        memcpy(ret->data, s1->data, s1->length);
+        memcpy(ret->data + s1->length, s2->data, s2->length);
         ret->data[ret->length] = 0;
+        ret->id = 0;
+        ret->num_references = 0;
     }
 
     return ret;
 }
 
+void string_append_cstr(string_t* str, const char* app, size_t length) {
+    if(str != NULL) {
+        if(str->length + length + 1 > str->capacity) {
+            size_t capacity = str->capacity * 2;
+            if(capacity < str->length + length + 1)
+                capacity = str->length + length + 1;
+            str->data = (char*)_realloc(str->data, capacity);
+            str->capacity = capacity;
+        }
+        memcpy(str->data + str->length, app, length);
+        str->length += length;
+        str->data[str->length] = 0;
+        str->id = 0;
+    }
+}
+
+void string_append(string_t* str, string_t* app) {
+    if(app != NULL)
+        string_append_cstr(str, app->data, app->length);
+}
+
 string_t* string_concat_and_free(string_t* s1, string_t* s2) {
     string_t* ret = string_concat(s1, s2);
     string_free(s1);
@@ -82,12 +109,15 @@ string_t* string_mult(string_t* str, size_t n) {
     if(str != NULL) {
         ret = (string_t*)_alloc(sizeof(string_t));
         ret->data = (char*)_alloc(sizeof(char)*(str->length * n + 1));
+        ret->capacity = str->length * n + 1;
         ret->length = 0;
         while(ret->length < str->length * n) {
             ret->data[ret->length] = str->data[ret->length % str->length];
             ret->length++;
         }
         ret->data[ret->length] = 0;
+        ret->id = 0;
+        ret->num_references = 0;
     }
 
     return ret;
@@ -101,20 +131,26 @@ string_t* string_substr(string_t* str, pos_t pos, pos_t n) {
             ret = (string_t*)_alloc(sizeof(string_t));
             ret->data = (char*)_alloc(sizeof(char)*(n + 1));
             ret->length = n;
+            ret->capacity = n + 1;
             while(n--) {
                 ret->data[n] = str->data[pos+n];
             }
             ret->data[ret->length] = 0;
+            ret->id = 0;
+            ret->num_references = 0;
         }
     } else {
         if(str != NULL && 0 < pos + n && pos < str->length) {
             ret = (string_t*)_alloc(sizeof(string_t));
             ret->data = (char*)_alloc(sizeof(char)*((-n) + 1));
             ret->length = -n;
+            ret->capacity = -n + 1;
             while(n++) {
                 ret->data[-n] = str->data[pos+n];
             }
             ret->data[ret->length] = 0;
+            ret->id = 0;
+            ret->num_references = 0;
         }
     }
 
@@ -172,24 +208,37 @@ size_t string_length(string_t* str) {
         return 0;
 }
 
-// TODO:
+// Hashes the string a word at a time, the last partial word is zero padded. The result is
+// finished with hash_mix and cached in the string, 0 marks a string that was not hashed yet.
 id_t string_id(string_t* str) {
-    id_t hash = 0;
-    for (int i = 0; i < str->length; i++) {
-        hash += (id_t)pow(SMALL_PRIME_1, str->length - (i+1)) * str->data[i];
+    if(str->id == 0) {
+        unsigned long hash = str->length;
+        size_t i = 0;
+        for(; i + sizeof(unsigned long) <= str->length; i += sizeof(unsigned long)) {
+            unsigned long word;
+            memcpy(&word, str->data + i, sizeof(unsigned long));
+            hash = (hash ^ word) * 0x9e3779b97f4a7c15UL;
+            hash ^= hash >> 29;
+        }
+        if(i < str->length) {
+            unsigned long word = 0;
+            memcpy(&word, str->data + i, str->length - i);
+            hash = (hash ^ word) * 0x9e3779b97f4a7c15UL;
+        }
+        str->id = hash_mix(hash);
+        if(str->id == 0)
+            str->id = 1;
     }
-    return (id_t)hash;
+    return str->id;
 }
 
 bool_t string_equ(string_t* s1, string_t* s2) {
     if(s1 != NULL && s2 != NULL) {
         if(s1->length != s2->length)
             return false;
-        int i;
-        for(i = 0; i < s1->length; i++)
-            if(s1->data[i] != s2->data[i])
-                return false;
-        return true;
+        if(s1->id != 0 && s2->id != 0 && s1->id != s2->id)
+            return false;
+        return memcmp(s1->data, s2->data, s1->length) == 0;
     } else 
         return s1 == s2;
 }
@@ -215,7 +264,9 @@ char string_char_at(string_t* str, pos_t pos) {
 }
 
 void string_free(string_t* str) {
-    if(str != NULL) {
+    if(str != NULL && str->num_references > 0)
+        str->num_references--;
+    else if(str != NULL) {
         if(str->data != NULL)
             _free(str->data);
         str->length = 0;
@@ -9,13 +9,19 @@
 typedef struct string_s {
     char* data;
     size_t length;
+    size_t capacity;        // Bytes allocated for data
+    id_t id;    // cached string_id, 0 if not yet computed
+    size_t num_references;  // Copies sharing this string besides the original
 } string_t;
 
 string_t* string_create(const char* str);
 string_t* string_create_full(const char* str, size_t length);
-string_t* string_copy(string_t* str);
+string_t* string_create_sized(size_t capacity); // Empty string with room for capacity-1 chars, to be filled with string_append
+string_t* string_copy(string_t* str); // Shares str, it is freed once every copy is freed
 string_t* string_concat(string_t* s1, string_t* s2);
 string_t* string_concat_and_free(string_t* s1, string_t* s2);
+void string_append(string_t* str, string_t* app); // Changes str, so it must not be shared
+void string_append_cstr(string_t* str, const char* app, size_t length);
 string_t* string_mult(string_t* str, size_t n);
 string_t* string_substr(string_t* str, pos_t pos, pos_t n);
 pos_t string_find(string_t* str, string_t* find);
@@ -4,7 +4,7 @@
 #include "./error.h"
 
 struct_t* struct_create() {
-    return environment_create();
+    return environment_create_with(variabletable_create_shaped());
 }
 
 void* struct_exec(struct_t* stc, operation_t* op) {
@@ -39,6 +39,18 @@ object_t** struct_result(struct_t* stc, operation_t* op) {
     return ret;
 }
 
+void struct_result_into(struct_t* stc, operation_t* op, result_t* res) {
+    if(check_for_stackoverflow()) {
+        error("Runtime error: Stack overflow.");
+        result_set(res, RET_ERROR);
+    } else {
+        int prev_local_limit = stc->local_mode_limit;
+        environment_set_local_mode(stc, 0);
+        operation_result_into(op, stc, res);
+        environment_set_local_mode(stc, prev_local_limit);
+    }
+}
+
 object_t*** struct_var(struct_t* stc, operation_t* op) {
     object_t*** ret;
 
@@ -55,6 +67,11 @@ object_t*** struct_var(struct_t* stc, operation_t* op) {
     return ret;
 }
 
+void struct_visit(struct_t* stc, object_visitor_t visit) {
+    for(size_t i = 0; i < stc->count; i++)
+        variabletable_visit(stc->data[i], visit);
+}
+
 void struct_free(struct_t* stc) {
     environment_free(stc);
 }
@@ -12,7 +12,9 @@ typedef environment_t struct_t;
 struct_t* struct_create();
 void* struct_exec(struct_t* stc, operation_t* op);
 object_t** struct_result(struct_t* stc, operation_t* op);
+void struct_result_into(struct_t* stc, operation_t* op, result_t* res);
 object_t*** struct_var(struct_t* stc, operation_t* op);
+void struct_visit(struct_t* stc, object_visitor_t visit); // Visits the members, including self
 void struct_free(struct_t* stc);
 id_t struct_id(struct_t* stc);
 bool_t struct_equ(struct_t* s1, struct_t* s2);
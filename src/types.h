@@ -16,5 +16,6 @@ typedef unsigned char uchar_t;
 
 
 typedef struct object_s object_t;
+typedef void (*object_visitor_t)(object_t* obj);
 
 #endif
\ No newline at end of file
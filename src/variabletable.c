@@ -1,12 +1,16 @@
 // Copyright (c) 2018-2019 Roland Bernard
 
-#include <math.h>
-
 #include "./prime.h"
 #include "./object.h"
 #include "./variabletable.h"
 #include "./langallocator.h"
 
+static size_t variabletable_generation = 0;
+
+void variabletable_touch(variabletable_t* tbl) {
+    tbl->generation = ++variabletable_generation;
+}
+
 // TODO: Improve collision handling (Double hashing)
 upos_t variabletable_find(variabletable_t* tbl, string_t* name) {
     if(tbl != NULL) {
@@ -57,21 +61,111 @@ void variabletable_check_size(variabletable_t* tbl) {
     }
 }
 
+object_t** variabletable_slot(variabletable_t* tbl, size_t slot) {
+    size_t block = 0;
+    size_t block_size = VARIABLETABLE_BLOCK_SIZE;
+    while(slot >= block_size) {
+        slot -= block_size;
+        block_size *= 2;
+        block++;
+    }
+    return tbl->slot_blocks[block] + slot;
+}
+
+// Adds the slot for name to a shaped table, the new slot is NULL
+static object_t** variabletable_add_slot(variabletable_t* tbl, string_t* name) {
+    if(tbl->count == tbl->size) {
+        size_t block_size = VARIABLETABLE_BLOCK_SIZE << tbl->num_blocks;
+        tbl->slot_blocks = (object_t***)_realloc(tbl->slot_blocks, sizeof(object_t**)*(tbl->num_blocks+1));
+        tbl->slot_blocks[tbl->num_blocks] = (object_t**)_alloc(sizeof(object_t*)*block_size);
+        tbl->num_blocks++;
+        tbl->size += block_size;
+    }
+    tbl->shape = shape_add(tbl->shape, name);
+    object_t** ret = variabletable_slot(tbl, tbl->count);
+    tbl->count++;
+    variabletable_touch(tbl);
+    *ret = NULL;
+    return ret;
+}
+
+static void variabletable_free_slots(variabletable_t* tbl) {
+    for(size_t i = 0; i < tbl->num_blocks; i++)
+        _free(tbl->slot_blocks[i]);
+    _free(tbl->slot_blocks);
+    tbl->slot_blocks = NULL;
+    tbl->num_blocks = 0;
+}
+
+static void variabletable_init_buckets(variabletable_t* tbl) {
+    size_t real_size = next_prime(DEFAULT_START_SIZE);
+
+    tbl->count = 0;
+    tbl->data = (bucket_element_t**)_alloc(sizeof(bucket_element_t*) * real_size);
+    for(int i = 0; i < real_size; i++)
+        tbl->data[i] = NULL;
+    tbl->size = real_size;
+}
+
+// Moves the values of a shaped table into buckets, used once members are deleted
+static void variabletable_unshape(variabletable_t* tbl) {
+    shape_t* shape = tbl->shape;
+    variabletable_t old = *tbl;
+
+    tbl->shape = NULL;
+    tbl->slot_blocks = NULL;
+    tbl->num_blocks = 0;
+    variabletable_init_buckets(tbl);
+    for(size_t i = 0; i < shape->count; i++) {
+        upos_t index = variabletable_find(tbl, shape->names[i]);
+        tbl->data[index] = (bucket_element_t*)_alloc(sizeof(bucket_element_t));
+        tbl->data[index]->name = string_copy(shape->names[i]);
+        tbl->data[index]->value = *variabletable_slot(&old, i);
+        tbl->count++;
+        variabletable_check_size(tbl);
+    }
+    variabletable_free_slots(&old);
+}
+
 variabletable_t* variabletable_create() {
     variabletable_t* ret = (variabletable_t*)_alloc(sizeof(variabletable_t));
-    size_t real_size = next_prime(DEFAULT_START_SIZE);
 
+    // The buckets are only allocated once the first variable is added
+    ret->data = NULL;
+    ret->size = 0;
     ret->count = 0;
-    ret->data = (bucket_element_t**)_alloc(sizeof(bucket_element_t*) * real_size);
-    for(int i = 0; i < real_size; i++)
-        ret->data[i] = NULL;
-    ret->size = real_size;
+    ret->shape = NULL;
+    ret->slot_blocks = NULL;
+    ret->num_blocks = 0;
+    variabletable_touch(ret);
+
+    return ret;
+}
+
+variabletable_t* variabletable_create_shaped() {
+    variabletable_t* ret = (variabletable_t*)_alloc(sizeof(variabletable_t));
+
+    ret->data = NULL;
+    ret->size = 0;
+    ret->count = 0;
+    ret->shape = shape_root();
+    ret->slot_blocks = NULL;
+    ret->num_blocks = 0;
+    variabletable_touch(ret);
 
     return ret;
 }
 
 void variabletable_make(variabletable_t* tbl, string_t* name) {
-    if(tbl != NULL) {
+    if(tbl != NULL && tbl->shape != NULL) {
+        if(shape_find(tbl->shape, name) == -1) {
+            object_t** slot = variabletable_add_slot(tbl, name);
+            *slot = object_create_none();
+            object_reference(*slot);
+        }
+    } else if(tbl != NULL) {
+        if(tbl->data == NULL)
+            variabletable_init_buckets(tbl);
         upos_t index = variabletable_find(tbl, name);
         if(tbl->data[index] == NULL) {
             tbl->data[index] = (bucket_element_t*)_alloc(sizeof(bucket_element_t));
@@ -80,12 +174,19 @@ void variabletable_make(variabletable_t* tbl, string_t* name) {
             object_reference(tbl->data[index]->value);
             tbl->count++;
             variabletable_check_size(tbl);
+            variabletable_touch(tbl);
         }
     }
 }
 
 void variabletable_del(variabletable_t* tbl, string_t* name) {
     if(tbl != NULL) {
+        if(tbl->shape != NULL) {
+            if(shape_find(tbl->shape, name) == -1)
+                return;
+            variabletable_unshape(tbl);
+        } else if(tbl->data == NULL)
+            return;
         upos_t index = variabletable_find(tbl, name);
         if(tbl->data[index] != NULL) {
             string_free(tbl->data[index]->name);
@@ -94,12 +195,21 @@ void variabletable_del(variabletable_t* tbl, string_t* name) {
             tbl->data[index] = NULL;
             tbl->count--;
             variabletable_check_size(tbl);
+            variabletable_touch(tbl);
         }
     }
 }
 
 void variabletable_write(variabletable_t* tbl, string_t* name, object_t* data) {
-    if(tbl != NULL) {
+    if(tbl != NULL && tbl->shape != NULL) {
+        long slot = shape_find(tbl->shape, name);
+        object_t** loc = slot == -1 ? variabletable_add_slot(tbl, name) : variabletable_slot(tbl, slot);
+        object_dereference(*loc);
+        *loc = data;
+        object_reference(data);
+    } else if(tbl != NULL) {
+        if(tbl->data == NULL)
+            variabletable_init_buckets(tbl);
         upos_t index = variabletable_find(tbl, name);
         if(tbl->data[index] == NULL) {
             tbl->data[index] = (bucket_element_t*)_alloc(sizeof(bucket_element_t));
@@ -107,6 +217,7 @@ void variabletable_write(variabletable_t* tbl, string_t* name, object_t* data) {
             tbl->data[index]->value = NULL;
             tbl->count++;
             variabletable_check_size(tbl);
+            variabletable_touch(tbl);
         }
         index = variabletable_find(tbl, name);
         object_dereference(tbl->data[index]->value);
@@ -116,7 +227,10 @@ void variabletable_write(variabletable_t* tbl, string_t* name, object_t* data) {
 }
 
 object_t* variabletable_get(variabletable_t* tbl, string_t* name) {
-    if(tbl != NULL) {
+    if(tbl != NULL && tbl->shape != NULL) {
+        long slot = shape_find(tbl->shape, name);
+        return slot == -1 ? NULL : *variabletable_slot(tbl, slot);
+    } else if(tbl != NULL && tbl->data != NULL) {
         upos_t index = variabletable_find(tbl, name);
         if(tbl->data[index] == NULL)
             return NULL;
@@ -127,7 +241,17 @@ object_t* variabletable_get(variabletable_t* tbl, string_t* name) {
 }
 
 object_t** variabletable_get_loc(variabletable_t* tbl, string_t* name) {
-    if(tbl != NULL) {
+    if(tbl != NULL && tbl->shape != NULL) {
+        long slot = shape_find(tbl->shape, name);
+        if(slot != -1)
+            return variabletable_slot(tbl, slot);
+        object_t** loc = variabletable_add_slot(tbl, name);
+        *loc = object_create_none();
+        object_reference(*loc);
+        return loc;
+    } else if(tbl != NULL) {
+        if(tbl->data == NULL)
+            variabletable_init_buckets(tbl);
         upos_t index = variabletable_find(tbl, name);
         if(tbl->data[index] == NULL) {
             tbl->data[index] = (bucket_element_t*)_alloc(sizeof(bucket_element_t));
@@ -136,6 +260,7 @@ object_t** variabletable_get_loc(variabletable_t* tbl, string_t* name) {
             object_reference(tbl->data[index]->value);
             tbl->count++;
             variabletable_check_size(tbl);
+            variabletable_touch(tbl);
         }
         index = variabletable_find(tbl, name);
         return &(tbl->data[index]->value);
@@ -144,34 +269,92 @@ object_t** variabletable_get_loc(variabletable_t* tbl, string_t* name) {
 }
 
 bool_t variabletable_exists(variabletable_t* tbl, string_t* name) {
-    return tbl->data[variabletable_find(tbl, name)] != NULL;
+    if(tbl->shape != NULL)
+        return shape_find(tbl->shape, name) != -1;
+    else
+        return tbl->data != NULL && tbl->data[variabletable_find(tbl, name)] != NULL;
 }
 
+// Independent of the order of the members, so that shaped and hashed tables agree
 id_t variabletable_id(variabletable_t* tbl) {
     long hash = 0;
-    int count_hashed = 0;
-    for (int i = 0; i < tbl->size; i++) 
-        if(tbl->data[i] != NULL) {
-            count_hashed++;
-            hash += (long)pow(SMALL_PRIME_4, tbl->count - count_hashed) * (string_id(tbl->data[i]->name) + object_id(tbl->data[i]->value) * BIG_PRIME_3);
-        }
+    if(tbl->shape != NULL) {
+        for(size_t i = 0; i < tbl->count; i++)
+            hash += string_id(tbl->shape->names[i]) + object_id(*variabletable_slot(tbl, i)) * BIG_PRIME_3;
+    } else {
+        for (int i = 0; i < tbl->size; i++)
+            if(tbl->data[i] != NULL)
+                hash += string_id(tbl->data[i]->name) + object_id(tbl->data[i]->value) * BIG_PRIME_3;
+    }
     return (id_t)hash;
 }
 
 bool_t variabletable_equ(variabletable_t* t1, variabletable_t* t2) {
     if(t1->count != t2->count)
         return false;
-    
-    for(int i = 0; i < t1->size; i++)
-        if(t1->data[i] != NULL)
-            if(!object_equ(t1->data[i]->value, variabletable_get(t2, t1->data[i]->name)))
+
+    if(t1->shape != NULL) {
+        for(size_t i = 0; i < t1->count; i++)
+            if(!object_equ(*variabletable_slot(t1, i), variabletable_get(t2, t1->shape->names[i])))
                 return false;
+    } else {
+        for(int i = 0; i < t1->size; i++)
+            if(t1->data[i] != NULL)
+                if(!object_equ(t1->data[i]->value, variabletable_get(t2, t1->data[i]->name)))
+                    return false;
+    }
 
     return true;
 }
 
+void variabletable_visit(variabletable_t* tbl, object_visitor_t visit) {
+    if(tbl != NULL) {
+        if(tbl->shape != NULL) {
+            for(size_t i = 0; i < tbl->count; i++)
+                visit(*variabletable_slot(tbl, i));
+        } else if(tbl->data != NULL) {
+            for(int i = 0; i < tbl->size; i++)
+                if(tbl->data[i] != NULL)
+                    visit(tbl->data[i]->value);
+        }
+    }
+}
+
+void variabletable_clear(variabletable_t* tbl) {
+    if(tbl != NULL) {
+        if(tbl->shape != NULL) {
+            for(size_t i = 0; i < tbl->count; i++)
+                object_dereference(*variabletable_slot(tbl, i));
+            variabletable_free_slots(tbl);
+            tbl->shape = shape_root();
+            tbl->size = 0;
+        } else if(tbl->data != NULL) {
+            for(int i = 0; i < tbl->size; i++)
+                if(tbl->data[i] != NULL) {
+                    string_free(tbl->data[i]->name);
+                    object_dereference(tbl->data[i]->value);
+                    _free(tbl->data[i]);
+                    tbl->data[i] = NULL;
+                }
+            // Buckets that grew are given back, the table starts out small again
+            if(tbl->size > DEFAULT_START_SIZE) {
+                _free(tbl->data);
+                tbl->data = NULL;
+                tbl->size = 0;
+            }
+        }
+        tbl->count = 0;
+        variabletable_touch(tbl);
+    }
+}
+
 void variabletable_free(variabletable_t* tbl) {
     if(tbl != NULL) {
+        if(tbl->shape != NULL) {
+            for(size_t i = 0; i < tbl->count; i++)
+                object_dereference(*variabletable_slot(tbl, i));
+            variabletable_free_slots(tbl);
+        }
         if(tbl->data != NULL) {
             for(int i = 0; i < tbl->size; i++)
                 if(tbl->data[i] != NULL) {
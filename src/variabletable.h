@@ -4,30 +4,43 @@
 #define __VARIABLETABLE_H__
 
 #define DEFAULT_START_SIZE 11
+// Number of values in the first slot block of a shaped table, every further block is twice as big
+#define VARIABLETABLE_BLOCK_SIZE 4
 
 #include "./types.h"
 #include "./bool.h"
 #include "./string.h"
+#include "./shape.h"
 
 typedef struct variabletable_s {
     struct bucket_element_s {
         string_t* name;
         object_t* value;
     }** data;
-    size_t size;
-    size_t count; 
+    size_t size;        // In shaped tables the number of slots allocated
+    size_t count;
+    // Shaped tables keep the names in the shape and the values in blocks that are never moved
+    shape_t* shape;
+    object_t*** slot_blocks;
+    size_t num_blocks;
+    size_t generation;  // Unique stamp, changed whenever variables are added or removed
 } variabletable_t;
 typedef struct bucket_element_s bucket_element_t;
 
 variabletable_t* variabletable_create();
+variabletable_t* variabletable_create_shaped(); // Table for the members of a struct
 void variabletable_make(variabletable_t* tbl, string_t* name);
 void variabletable_del(variabletable_t* tbl, string_t* name);
 void variabletable_write(variabletable_t* tbl, string_t* name, object_t* data);
 object_t* variabletable_get(variabletable_t* tbl, string_t* name);
 object_t** variabletable_get_loc(variabletable_t* tbl, string_t* name);
+object_t** variabletable_slot(variabletable_t* tbl, size_t slot); // Location of a slot of a shaped table
 bool_t variabletable_exists(variabletable_t* tbl, string_t* name);
 id_t variabletable_id(variabletable_t* tbl);
 bool_t variabletable_equ(variabletable_t* t1, variabletable_t* t2);
+void variabletable_visit(variabletable_t* tbl, object_visitor_t visit);
+void variabletable_clear(variabletable_t* tbl); // Removes all variables but keeps the table for reuse
+void variabletable_touch(variabletable_t* tbl); // Gives the table a new generation
 void variabletable_free(variabletable_t* tbl);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,1931 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#include <math.h>
+
+#include "./vm.h"
+#include "./bytecode.h"
+#include "./jit.h"
+#include "./object.h"
+#include "./langallocator.h"
+#include "./error.h"
+
+#define VM_LOCAL_BUFFER 16
+
+static object_t** vm_values = NULL;
+static size_t vm_values_count = 0;
+static size_t vm_values_size = 0;
+
+static object_t*** vm_locations = NULL;
+static size_t vm_locations_count = 0;
+static size_t vm_locations_size = 0;
+
+static long* vm_status = NULL;
+static size_t vm_status_count = 0;
+static size_t vm_status_size = 0;
+
+static list_t** vm_accumulators = NULL;
+static size_t vm_accumulators_count = 0;
+static size_t vm_accumulators_size = 0;
+
+static size_t* vm_limits = NULL;
+static size_t vm_limits_count = 0;
+static size_t vm_limits_size = 0;
+
+static void vm_push_value(object_t* obj) {
+    if(vm_values_count == vm_values_size) {
+        vm_values_size = vm_values_size == 0 ? 64 : vm_values_size*2;
+        vm_values = (object_t**)_realloc(vm_values, sizeof(object_t*)*vm_values_size);
+    }
+    vm_values[vm_values_count++] = obj;
+}
+
+static void vm_push_location(object_t** loc) {
+    if(vm_locations_count == vm_locations_size) {
+        vm_locations_size = vm_locations_size == 0 ? 16 : vm_locations_size*2;
+        vm_locations = (object_t***)_realloc(vm_locations, sizeof(object_t**)*vm_locations_size);
+    }
+    vm_locations[vm_locations_count++] = loc;
+}
+
+static void vm_push_status(long status) {
+    if(vm_status_count == vm_status_size) {
+        vm_status_size = vm_status_size == 0 ? 64 : vm_status_size*2;
+        vm_status = (long*)_realloc(vm_status, sizeof(long)*vm_status_size);
+    }
+    vm_status[vm_status_count++] = status;
+}
+
+static void vm_push_accumulator(list_t* list) {
+    if(vm_accumulators_count == vm_accumulators_size) {
+        vm_accumulators_size = vm_accumulators_size == 0 ? 8 : vm_accumulators_size*2;
+        vm_accumulators = (list_t**)_realloc(vm_accumulators, sizeof(list_t*)*vm_accumulators_size);
+    }
+    vm_accumulators[vm_accumulators_count++] = list;
+}
+
+static void vm_push_limit(size_t limit) {
+    if(vm_limits_count == vm_limits_size) {
+        vm_limits_size = vm_limits_size == 0 ? 8 : vm_limits_size*2;
+        vm_limits = (size_t*)_realloc(vm_limits, sizeof(size_t)*vm_limits_size);
+    }
+    vm_limits[vm_limits_count++] = limit;
+}
+
+static void vm_push_object(object_t* obj) {
+    object_reference(obj);
+    vm_push_value(obj);
+    vm_push_status(1);
+}
+
+static void vm_push_array(object_t** vals) {
+    if(vals == NULL) {
+        vm_push_status(VM_STATUS_NULL);
+    } else if(vals == RET_ERROR) {
+        vm_push_status(VM_STATUS_ERROR);
+    } else {
+        long num_vals = 0;
+        while(vals[num_vals] != NULL) {
+            vm_push_value(vals[num_vals]);
+            num_vals++;
+        }
+        _free(vals);
+        vm_push_status(num_vals);
+    }
+}
+
+static void vm_push_result(result_t* res) {
+    if(res->values == NULL) {
+        vm_push_status(VM_STATUS_NULL);
+    } else if(res->values == RET_ERROR) {
+        vm_push_status(VM_STATUS_ERROR);
+    } else {
+        for(size_t i = 0; i < res->length; i++)
+            vm_push_value(res->values[i]);
+        vm_push_status(res->length);
+        result_free(res);
+    }
+}
+
+static void vm_push_location_array(object_t*** locs) {
+    if(locs == NULL) {
+        vm_push_status(VM_STATUS_NULL);
+    } else if(locs == RET_ERROR) {
+        vm_push_status(VM_STATUS_ERROR);
+    } else {
+        long num_locs = 0;
+        while(locs[num_locs] != NULL) {
+            vm_push_location(locs[num_locs]);
+            num_locs++;
+        }
+        _free(locs);
+        vm_push_status(num_locs);
+    }
+}
+
+static void vm_drop_values(long status) {
+    while(status > 0) {
+        object_dereference(vm_values[--vm_values_count]);
+        status--;
+    }
+}
+
+static void vm_drop_group() {
+    vm_drop_values(vm_status[--vm_status_count]);
+}
+
+static void vm_drop_location_group() {
+    long status = vm_status[--vm_status_count];
+    if(status > 0)
+        vm_locations_count -= status;
+}
+
+static void vm_forin_drop_state() {
+    vm_status_count--;
+    vm_drop_group();
+    vm_drop_location_group();
+}
+
+static const char* vm_null_msg(operation_type_t type) {
+    switch(type) {
+        case OPERATION_TYPE_O_LIST: return "Runtime error: Open list NULL error.";
+        case OPERATION_TYPE_ADD: return "Runtime error: Addition NULL error.";
+        case OPERATION_TYPE_SUB: return "Runtime error: Subtraction NULL error.";
+        case OPERATION_TYPE_MUL: return "Runtime error: Multiplication NULL error.";
+        case OPERATION_TYPE_DIV: return "Runtime error: Division NULL error.";
+        case OPERATION_TYPE_MOD: return "Runtime error: Modulo NULL error.";
+        case OPERATION_TYPE_POW: return "Runtime error: Power NULL error.";
+        case OPERATION_TYPE_AND: return "Runtime error: And NULL error.";
+        case OPERATION_TYPE_OR: return "Runtime error: Or NULL error.";
+        case OPERATION_TYPE_XOR: return "Runtime error: Xor NULL error.";
+        case OPERATION_TYPE_NEG: return "Runtime error: Negate NULL error.";
+        case OPERATION_TYPE_NOT: return "Runtime error: Not NULL error.";
+        case OPERATION_TYPE_EQU: return "Runtime error: Equ NULL error.";
+        default: return "Runtime error: Compare NULL error.";
+    }
+}
+
+static const char* vm_type_msg(operation_type_t type) {
+    switch(type) {
+        case OPERATION_TYPE_SUB: return "Runtime error: Subtraction type error.";
+        case OPERATION_TYPE_DIV: return "Runtime error: Division type error.";
+        case OPERATION_TYPE_MOD: return "Runtime error: Modulo type error.";
+        case OPERATION_TYPE_POW: return "Runtime error: Power type error.";
+        case OPERATION_TYPE_AND: return "Runtime error: And type error.";
+        case OPERATION_TYPE_OR: return "Runtime error: Or type error.";
+        case OPERATION_TYPE_XOR: return "Runtime error: Xor type error.";
+        case OPERATION_TYPE_NEG: return "Runtime error: Negate type error.";
+        case OPERATION_TYPE_NOT: return "Runtime error: Not type error.";
+        default: return NULL;
+    }
+}
+
+static const char* vm_symmetry_msg(operation_type_t type) {
+    switch(type) {
+        case OPERATION_TYPE_ADD: return "Runtime error: Addition symmetry error.";
+        case OPERATION_TYPE_SUB: return "Runtime error: Subtraction symmetry error.";
+        case OPERATION_TYPE_MUL: return "Runtime error: Multiplication symmetry error.";
+        case OPERATION_TYPE_DIV: return "Runtime error: Division symmetry error.";
+        case OPERATION_TYPE_MOD: return "Runtime error: Modulo symmetry error.";
+        case OPERATION_TYPE_POW: return "Runtime error: Power symmetry error.";
+        case OPERATION_TYPE_AND: return "Runtime error: And symmetry error.";
+        case OPERATION_TYPE_OR: return "Runtime error: Or symmetry error.";
+        case OPERATION_TYPE_XOR: return "Runtime error: Xor symmetry error.";
+        default: return NULL;
+    }
+}
+
+static object_type_t vm_operand_type(operation_type_t type) {
+    switch(type) {
+        case OPERATION_TYPE_SUB:
+        case OPERATION_TYPE_DIV:
+        case OPERATION_TYPE_MOD:
+        case OPERATION_TYPE_POW:
+        case OPERATION_TYPE_NEG:
+            return OBJECT_TYPE_NUMBER;
+        case OPERATION_TYPE_AND:
+        case OPERATION_TYPE_OR:
+        case OPERATION_TYPE_XOR:
+        case OPERATION_TYPE_NOT:
+            return OBJECT_TYPE_BOOL;
+        default:
+            return OBJECT_TYPE_FREED;
+    }
+}
+
+static const char* vm_cond_msg(cond_msg_t msg, bool_t null) {
+    switch(msg) {
+        case COND_MSG_IF: return null ? "Runtime error: If NULL error." : "Runtime error: If non-scalar condition error.";
+        case COND_MSG_IFELSE: return null ? "Runtime error: If-else NULL error." : "Runtime error: If-else non-scalar condition error.";
+        case COND_MSG_WHILE: return null ? "Runtime error: While NULL error." : "Runtime error: While non-scalar condition error.";
+        case COND_MSG_FOR: return null ? "Runtime error: For NULL error." : "Runtime error: For non-scalar condition error.";
+        default: return null ? "Runtime error: while NULL error." : "Runtime error: while non-scalar condition error.";
+    }
+}
+
+// Checks operand num_prev of op, the previous operands are the value groups below it
+static bool_t vm_check_operand(operation_type_t type, long num_prev) {
+    long status = vm_status[vm_status_count-1];
+
+    if(status == VM_STATUS_NULL) {
+        error(vm_null_msg(type));
+        return false;
+    } else if(status == VM_STATUS_ERROR) {
+        return false;
+    } else if(type != OPERATION_TYPE_O_LIST) {
+        bool_t ret = true;
+        object_type_t operand_type = vm_operand_type(type);
+        object_t** vals = vm_values + vm_values_count - status;
+
+        long tmp_size = 0;
+        if(operand_type != OBJECT_TYPE_FREED)
+            while(ret && tmp_size < status) {
+                if(vals[tmp_size]->type != operand_type) {
+                    error(vm_type_msg(type));
+                    ret = false;
+                } else if(type == OPERATION_TYPE_MOD && !number_is_integer(vals[tmp_size]->data.number)) {
+                    error("Runtime error: Modulo non-integer Error");
+                    ret = false;
+                } else
+                    tmp_size++;
+            }
+        else
+            tmp_size = status;
+
+        if(ret || (type != OPERATION_TYPE_SUB && type != OPERATION_TYPE_DIV)) {
+            long num_ret = 1;
+            for(long i = num_prev; i > 0; i--) {
+                long prev = vm_status[vm_status_count-1-i];
+                if(num_ret == 1 && prev != 1)
+                    num_ret = prev;
+            }
+            if(!(num_ret == 1 && tmp_size != 1) && num_ret != tmp_size && tmp_size != 1) {
+                error(vm_symmetry_msg(type));
+                ret = false;
+            }
+        }
+        return ret;
+    } else
+        return true;
+}
+
+static object_t* vm_arithmetic_part(operation_type_t type, object_t*** vals, long* status, long num_op, long i) {
+    object_t* ret = NULL;
+    #define VM_OPERAND(J) (status[J] == 1 ? vals[J][0] : vals[J][i])
+    switch(type) {
+        case OPERATION_TYPE_ADD:
+        case OPERATION_TYPE_MUL: {
+            ret = VM_OPERAND(0);
+            object_reference(ret);
+            for(long j = 1; j < num_op; j++) {
+                object_t* tmp;
+                if(ret->type == OBJECT_TYPE_NUMBER && VM_OPERAND(j)->type == OBJECT_TYPE_NUMBER)
+                    tmp = object_create_number(type == OPERATION_TYPE_ADD ?
+                        ret->data.number + VM_OPERAND(j)->data.number : ret->data.number * VM_OPERAND(j)->data.number);
+                else if(type == OPERATION_TYPE_ADD)
+                    tmp = object_add(ret, VM_OPERAND(j));
+                else
+                    tmp = object_mul(ret, VM_OPERAND(j));
+                object_dereference(ret);
+                if(tmp == RET_ERROR)
+                    return RET_ERROR;
+                ret = tmp;
+                object_reference(ret);
+            }
+        } break;
+        case OPERATION_TYPE_SUB:
+        case OPERATION_TYPE_DIV: {
+            number_t ret_part = VM_OPERAND(0)->data.number;
+            for(long j = 1; j < num_op; j++) {
+                if(type == OPERATION_TYPE_SUB)
+                    ret_part -= VM_OPERAND(j)->data.number;
+                else
+                    ret_part /= VM_OPERAND(j)->data.number;
+            }
+            ret = object_create_number(ret_part);
+        } break;
+        case OPERATION_TYPE_MOD: {
+            long ret_part = (long)(VM_OPERAND(0)->data.number);
+            for(long j = 1; j < num_op; j++)
+                ret_part %= (long)(VM_OPERAND(j)->data.number);
+            ret = object_create_number(ret_part);
+        } break;
+        case OPERATION_TYPE_POW: {
+            number_t ret_part = (int)(VM_OPERAND(num_op-1)->data.number);
+            for(long j = num_op-2; j >= 0; j--)
+                ret_part = pow(VM_OPERAND(j)->data.number, ret_part);
+            ret = object_create_number(ret_part);
+        } break;
+        case OPERATION_TYPE_AND:
+        case OPERATION_TYPE_OR:
+        case OPERATION_TYPE_XOR: {
+            bool_t ret_part = type == OPERATION_TYPE_AND;
+            for(long j = 0; j < num_op; j++) {
+                if(type == OPERATION_TYPE_AND)
+                    ret_part = ret_part && VM_OPERAND(j)->data.boolean;
+                else if(type == OPERATION_TYPE_OR)
+                    ret_part = ret_part || VM_OPERAND(j)->data.boolean;
+                else
+                    ret_part = ret_part != VM_OPERAND(j)->data.boolean;
+            }
+            ret = object_create_boolean(ret_part);
+        } break;
+        default: break;
+    }
+    #undef VM_OPERAND
+    if(type != OPERATION_TYPE_ADD && type != OPERATION_TYPE_MUL)
+        object_reference(ret);
+    return ret;
+}
+
+static void vm_arithmetic(operation_type_t type, long num_op) {
+    object_t** vals_buffer[VM_LOCAL_BUFFER];
+    object_t*** vals = num_op > VM_LOCAL_BUFFER ? (object_t***)_alloc(sizeof(object_t**)*num_op) : vals_buffer;
+    long* status = vm_status + vm_status_count - num_op;
+
+    long num_vals = 0;
+    long num_ret = 1;
+    for(long j = 0; j < num_op; j++) {
+        num_vals += status[j];
+        if(num_ret == 1 && status[j] != 1)
+            num_ret = status[j];
+    }
+    object_t** base = vm_values + vm_values_count - num_vals;
+    for(long j = 0; j < num_op; j++) {
+        vals[j] = base;
+        base += status[j];
+    }
+
+    object_t* ret_buffer[1];
+    object_t** ret = num_ret > 1 ? (object_t**)_alloc(sizeof(object_t*)*num_ret) : ret_buffer;
+    bool_t failed = false;
+    for(long i = 0; !failed && i < num_ret; i++) {
+        ret[i] = vm_arithmetic_part(type, vals, status, num_op, i);
+        if(ret[i] == RET_ERROR) {
+            for(long k = 0; k < i; k++)
+                object_dereference(ret[k]);
+            failed = true;
+        }
+    }
+
+    for(long j = 0; j < num_op; j++)
+        vm_drop_group();
+    if(failed) {
+        vm_push_status(VM_STATUS_ERROR);
+    } else {
+        for(long i = 0; i < num_ret; i++)
+            vm_push_value(ret[i]);
+        vm_push_status(num_ret);
+    }
+
+    if(ret != ret_buffer)
+        _free(ret);
+    if(vals != vals_buffer)
+        _free(vals);
+}
+
+static void vm_unary(operation_type_t type) {
+    long status = vm_status[vm_status_count-1];
+
+    if(status == VM_STATUS_NULL) {
+        error(vm_null_msg(type));
+        vm_status[vm_status_count-1] = VM_STATUS_ERROR;
+    } else if(status != VM_STATUS_ERROR) {
+        object_t** vals = vm_values + vm_values_count - status;
+        object_type_t operand_type = vm_operand_type(type);
+        bool_t failed = false;
+        for(long i = 0; !failed && i < status; i++)
+            if(vals[i]->type != operand_type) {
+                error(vm_type_msg(type));
+                failed = true;
+            }
+        if(failed) {
+            vm_drop_group();
+            vm_push_status(VM_STATUS_ERROR);
+        } else
+            for(long i = 0; i < status; i++) {
+                object_t* obj;
+                if(type == OPERATION_TYPE_NEG)
+                    obj = object_create_number(-vals[i]->data.number);
+                else
+                    obj = object_create_boolean(!vals[i]->data.boolean);
+                object_reference(obj);
+                object_dereference(vals[i]);
+                vals[i] = obj;
+            }
+    }
+}
+
+static bool_t vm_compare_part(operation_type_t type, object_t* left, object_t* right, object_t** ret) {
+    if(type == OPERATION_TYPE_EQU) {
+        *ret = object_create_boolean(object_equ(left, right));
+    } else if(left->type != OBJECT_TYPE_NUMBER || right->type != OBJECT_TYPE_NUMBER) {
+        error("Runtime error: Compare type error");
+        return false;
+    } else {
+        number_t l = left->data.number;
+        number_t r = right->data.number;
+        switch(type) {
+            case OPERATION_TYPE_GEQ: *ret = object_create_boolean(l >= r); break;
+            case OPERATION_TYPE_LEQ: *ret = object_create_boolean(l <= r); break;
+            case OPERATION_TYPE_GTR: *ret = object_create_boolean(l > r); break;
+            default: *ret = object_create_boolean(l < r); break;
+        }
+    }
+    object_reference(*ret);
+    return true;
+}
+
+static void vm_compare(operation_type_t type) {
+    long right_len = vm_status[vm_status_count-1];
+    long left_len = vm_status[vm_status_count-2];
+
+    if(left_len == VM_STATUS_NULL || right_len == VM_STATUS_NULL) {
+        error(vm_null_msg(type));
+        vm_drop_group();
+        vm_drop_group();
+        vm_push_status(VM_STATUS_ERROR);
+    } else if(left_len == VM_STATUS_ERROR || right_len == VM_STATUS_ERROR) {
+        vm_drop_group();
+        vm_drop_group();
+        vm_push_status(VM_STATUS_ERROR);
+    } else if(left_len > 1 && right_len > 1 && left_len != right_len) {
+        error(type == OPERATION_TYPE_EQU ? "Runtime error: Equ symmetry error" : "Runtime error: Compare symmetry error");
+        vm_drop_group();
+        vm_drop_group();
+        vm_push_status(VM_STATUS_ERROR);
+    } else {
+        object_t** left = vm_values + vm_values_count - right_len - left_len;
+        object_t** right = vm_values + vm_values_count - right_len;
+        long num_ret = left_len == 0 || right_len == 0 ? 0 : (left_len > right_len ? left_len : right_len);
+
+        object_t* ret_buffer[1];
+        object_t** ret = num_ret > 1 ? (object_t**)_alloc(sizeof(object_t*)*num_ret) : ret_buffer;
+        long i;
+        for(i = 0; i < num_ret; i++)
+            if(!vm_compare_part(type, left[left_len == 1 ? 0 : i], right[right_len == 1 ? 0 : i], ret + i))
+                break;
+
+        vm_drop_group();
+        vm_drop_group();
+        if(i < num_ret) {
+            for(long j = 0; j < i; j++)
+                object_dereference(ret[j]);
+            vm_push_status(VM_STATUS_ERROR);
+        } else {
+            for(i = 0; i < num_ret; i++)
+                vm_push_value(ret[i]);
+            vm_push_status(num_ret);
+        }
+        if(ret != ret_buffer)
+            _free(ret);
+    }
+}
+
+// Instructions rewrite themselves into number-only forms once they see scalar numbers. A failing
+// guard rewrites them back, and after VM_QUICKEN_MAX_DEOPTS failures they stay generic.
+#define VM_QUICKEN_MAX_DEOPTS 4
+
+static bool_t vm_quickens(operation_type_t type) {
+    return type == OPERATION_TYPE_ADD || type == OPERATION_TYPE_SUB || type == OPERATION_TYPE_MUL || type == OPERATION_TYPE_DIV;
+}
+
+// Only valid while the groups above group are scalars too
+static bool_t vm_scalar_number(long group) {
+    return vm_status[vm_status_count-1-group] == 1 && vm_values[vm_values_count-1-group]->type == OBJECT_TYPE_NUMBER;
+}
+
+// Replaces the two scalar groups on top with obj
+static void vm_replace_scalars(object_t* obj) {
+    object_reference(obj);
+    object_dereference(vm_values[--vm_values_count]);
+    object_dereference(vm_values[vm_values_count-1]);
+    vm_values[vm_values_count-1] = obj;
+    vm_status_count--;
+}
+
+static void vm_arithmetic_num(operation_type_t type) {
+    number_t l = vm_values[vm_values_count-2]->data.number;
+    number_t r = vm_values[vm_values_count-1]->data.number;
+    number_t ret;
+    switch(type) {
+        case OPERATION_TYPE_ADD: ret = l + r; break;
+        case OPERATION_TYPE_SUB: ret = l - r; break;
+        case OPERATION_TYPE_MUL: ret = l * r; break;
+        default: ret = l / r; break;
+    }
+    vm_replace_scalars(object_create_number(ret));
+}
+
+static void vm_compare_num(operation_type_t type) {
+    number_t l = vm_values[vm_values_count-2]->data.number;
+    number_t r = vm_values[vm_values_count-1]->data.number;
+    bool_t ret;
+    switch(type) {
+        case OPERATION_TYPE_EQU: ret = number_equ(l, r); break;
+        case OPERATION_TYPE_GEQ: ret = l >= r; break;
+        case OPERATION_TYPE_LEQ: ret = l <= r; break;
+        case OPERATION_TYPE_GTR: ret = l > r; break;
+        default: ret = l < r; break;
+    }
+    vm_replace_scalars(object_create_boolean(ret));
+}
+
+static void vm_index() {
+    long num_index = vm_status[vm_status_count-1];
+    long num_data = vm_status[vm_status_count-2];
+
+    if(num_data == VM_STATUS_NULL || num_index == VM_STATUS_NULL) {
+        error("Runtime error: Indexing NULL error.");
+        vm_drop_group();
+        vm_drop_group();
+        vm_push_status(VM_STATUS_ERROR);
+    } else if(num_data == VM_STATUS_ERROR || num_index == VM_STATUS_ERROR) {
+        vm_drop_group();
+        vm_drop_group();
+        vm_push_status(VM_STATUS_ERROR);
+    } else {
+        object_t* data = vm_values[vm_values_count-2];
+        object_t* index = vm_values[vm_values_count-1];
+        object_t* obj = NULL;
+
+        if(num_data == 1 && num_index == 1 && data->type == OBJECT_TYPE_LIST && index->type == OBJECT_TYPE_NUMBER) {
+            pos_t ind = number_to_long(index->data.number);
+            if(ind < 0)
+                ind += data->data.list->size;
+            obj = list_get(data->data.list, ind);
+            if(obj == NULL)
+                obj = object_create_none();
+        } else if(num_data == 1 && num_index == 1 && data->type == OBJECT_TYPE_DICTIONARY) {
+            obj = dictionary_get(data->data.dic, index);
+            if(obj == NULL)
+                obj = object_create_none();
+        }
+
+        if(obj != NULL) {
+            object_reference(obj);
+            vm_drop_group();
+            vm_drop_group();
+            vm_push_value(obj);
+            vm_push_status(1);
+        } else {
+            object_t** data_vals = (object_t**)_alloc(sizeof(object_t*)*(num_data+1));
+            object_t** index_vals = (object_t**)_alloc(sizeof(object_t*)*(num_index+1));
+            for(long i = 0; i < num_data; i++)
+                data_vals[i] = vm_values[vm_values_count-num_index-num_data+i];
+            data_vals[num_data] = NULL;
+            for(long i = 0; i < num_index; i++)
+                index_vals[i] = vm_values[vm_values_count-num_index+i];
+            index_vals[num_index] = NULL;
+
+            object_t** ret = operation_index(data_vals, index_vals);
+
+            _free(data_vals);
+            _free(index_vals);
+            vm_drop_group();
+            vm_drop_group();
+            vm_push_array(ret);
+        }
+    }
+}
+
+static void vm_assign(bool_t result) {
+    long num_loc = vm_status[vm_status_count-1];
+    long num_val = vm_status[vm_status_count-2];
+    bool_t failed = false;
+
+    if(num_loc == VM_STATUS_NULL || num_val == VM_STATUS_NULL) {
+        error("Runtime error: Assignment NULL error.");
+        failed = true;
+    } else if(num_loc == VM_STATUS_ERROR || num_val == VM_STATUS_ERROR) {
+        failed = true;
+    } else {
+        object_t*** assign_loc = vm_locations + vm_locations_count - num_loc;
+        object_t** assign_val = vm_values + vm_values_count - num_val;
+        for(long i = 0; i < num_loc && i < num_val; i++) {
+            if(assign_loc[i] == OBJECT_LIST_OPENED) {
+                object_t** obj = assign_loc[i+1];
+                object_dereference(*obj);
+
+                list_t* list = list_create_null(num_val - i);
+                for(long j = 0; j < num_val - i; j++) {
+                    list->data[j] = assign_val[i+j];
+                    object_reference(list->data[j]);
+                }
+                *obj = object_create_list(list);
+                object_reference(*obj);
+                break;
+            } else {
+                object_dereference(*(assign_loc[i]));
+                *(assign_loc[i]) = assign_val[i];
+                object_reference(*(assign_loc[i]));
+            }
+        }
+    }
+
+    vm_drop_location_group();
+    if(failed || !result) {
+        vm_drop_group();
+        vm_push_status(failed ? VM_STATUS_ERROR : 0);
+    }
+}
+
+static void vm_call(bool_t result, environment_t* env) {
+    long num_par = vm_status[--vm_status_count];
+    long num_func = vm_status[--vm_status_count];
+
+    object_t* par_buffer[VM_LOCAL_BUFFER];
+    object_t** par = NULL;
+    if(num_par >= 0) {
+        par = num_par >= VM_LOCAL_BUFFER ? (object_t**)_alloc(sizeof(object_t*)*(num_par+1)) : par_buffer;
+        for(long i = 0; i < num_par; i++)
+            par[i] = vm_values[vm_values_count-num_par+i];
+        par[num_par] = NULL;
+        vm_values_count -= num_par;
+    }
+    object_t* func_buffer[VM_LOCAL_BUFFER];
+    object_t** func = NULL;
+    if(num_func >= 0) {
+        func = num_func > VM_LOCAL_BUFFER ? (object_t**)_alloc(sizeof(object_t*)*num_func) : func_buffer;
+        for(long i = 0; i < num_func; i++)
+            func[i] = vm_values[vm_values_count-num_func+i];
+        vm_values_count -= num_func;
+    }
+
+    long num_ret = 0;
+    bool_t failed = false;
+    if(num_func == VM_STATUS_NULL) {
+        error("Runtime error: Function NULL error.");
+        failed = true;
+    } else if(num_func == VM_STATUS_ERROR || num_par == VM_STATUS_ERROR) {
+        failed = true;
+    } else
+        for(long i = 0; !failed && i < num_func; i++)
+            if(func[i]->type != OBJECT_TYPE_FUNCTION) {
+                error("Runtime error: Function type error.");
+                failed = true;
+            } else if(result) {
+                object_t** vals = function_result(func[i]->data.func, par, env);
+                if(vals == NULL) {
+                    error("Runtime error: Function NULL error");
+                    failed = true;
+                } else if(vals == RET_ERROR) {
+                    failed = true;
+                } else {
+                    for(long j = 0; vals[j] != NULL; j++) {
+                        vm_push_value(vals[j]);
+                        num_ret++;
+                    }
+                    _free(vals);
+                }
+            } else {
+                if(function_exec(func[i]->data.func, par, env) == RET_ERROR)
+                    failed = true;
+            }
+
+    if(failed) {
+        vm_drop_values(num_ret);
+        vm_push_status(VM_STATUS_ERROR);
+    } else
+        vm_push_status(num_ret);
+
+    if(par != NULL) {
+        for(long i = 0; i < num_par; i++)
+            object_dereference(par[i]);
+        if(par != par_buffer)
+            _free(par);
+    }
+    if(func != NULL) {
+        for(long i = 0; i < num_func; i++)
+            object_dereference(func[i]);
+        if(func != func_buffer)
+            _free(func);
+    }
+}
+
+static void vm_list_open() {
+    long status = vm_status[vm_status_count-1];
+
+    if(status == VM_STATUS_NULL) {
+        error("Runtime error: List-opening NULL error.");
+        vm_status[vm_status_count-1] = VM_STATUS_ERROR;
+    } else if(status != VM_STATUS_ERROR) {
+        object_t* lists_buffer[VM_LOCAL_BUFFER];
+        object_t** lists = status > VM_LOCAL_BUFFER ? (object_t**)_alloc(sizeof(object_t*)*status) : lists_buffer;
+        bool_t failed = false;
+        for(long i = 0; i < status; i++) {
+            lists[i] = vm_values[vm_values_count-status+i];
+            if(!failed && lists[i]->type != OBJECT_TYPE_LIST) {
+                error("Runtime error: List-opening type error.");
+                failed = true;
+            }
+        }
+        vm_status_count--;
+        vm_values_count -= status;
+
+        if(failed) {
+            vm_push_status(VM_STATUS_ERROR);
+        } else {
+            long num_ret = 0;
+            for(long i = 0; i < status; i++)
+                for(long j = 0; j < lists[i]->data.list->size; j++) {
+                    object_reference(lists[i]->data.list->data[j]);
+                    vm_push_value(lists[i]->data.list->data[j]);
+                    num_ret++;
+                }
+            vm_push_status(num_ret);
+        }
+
+        for(long i = 0; i < status; i++)
+            object_dereference(lists[i]);
+        if(lists != lists_buffer)
+            _free(lists);
+    }
+}
+
+static void vm_list_open_loc() {
+    long status = vm_status[vm_status_count-1];
+
+    if(status == VM_STATUS_NULL) {
+        error("Runtime error: List-opening NULL error.");
+        vm_status[vm_status_count-1] = VM_STATUS_ERROR;
+    } else if(status != VM_STATUS_ERROR) {
+        object_t** loc = status > 0 ? vm_locations[vm_locations_count-status] : NULL;
+        vm_drop_location_group();
+        if(loc == OBJECT_LIST_OPENED) {
+            error("Runtime error: List-open type error.");
+            vm_push_status(VM_STATUS_ERROR);
+        } else {
+            vm_push_location(OBJECT_LIST_OPENED);
+            vm_push_location(loc);
+            vm_push_status(2);
+        }
+    }
+}
+
+static object_t** vm_variable(instruction_t* inst, environment_t* env) {
+    // Variables are only added to the innermost scope, and a scope that is removed and added again
+    // is cleared, so its generation covers everything that can move or shadow the cached location
+    if(inst->cache_env != env || inst->cache_generation != env->data[env->count-1]->generation
+        || inst->cache_limit != env->local_mode_limit) {
+        inst->cache_loc = environment_get_var(env, inst->op->data.str);
+        inst->cache_env = env;
+        inst->cache_generation = env->data[env->count-1]->generation;
+        inst->cache_limit = env->local_mode_limit;
+    }
+    return inst->cache_loc;
+}
+
+static void vm_var_exec(instruction_t* inst, environment_t* env) {
+    object_t* var = *vm_variable(inst, env);
+    if(var->type == OBJECT_TYPE_MACRO && macro_exec(var->data.mac, env) == RET_ERROR)
+        vm_push_status(VM_STATUS_ERROR);
+    else
+        vm_push_status(0);
+}
+
+static void vm_var_result(instruction_t* inst, environment_t* env) {
+    object_t* var = *vm_variable(inst, env);
+    if(var->type == OBJECT_TYPE_MACRO)
+        vm_push_array(macro_result(var->data.mac, env));
+    else
+        vm_push_object(var);
+}
+
+static void vm_var_loc(instruction_t* inst, environment_t* env) {
+    object_t** loc = vm_variable(inst, env);
+    if((*loc)->type == OBJECT_TYPE_MACRO)
+        vm_push_location_array(macro_var((*loc)->data.mac, env));
+    else {
+        vm_push_location(loc);
+        vm_push_status(1);
+    }
+}
+
+// On failure the operands are replaced by an error group
+static bool_t vm_check(operation_type_t type, long num_prev) {
+    if(!vm_check_operand(type, num_prev)) {
+        for(long i = 0; i <= num_prev; i++)
+            vm_drop_group();
+        vm_push_status(VM_STATUS_ERROR);
+        return false;
+    }
+    return true;
+}
+
+static bool_t vm_check_loc(long num_prev) {
+    long status = vm_status[vm_status_count-1];
+    if(status < 0) {
+        if(status == VM_STATUS_NULL)
+            error("Runtime error: Open list NULL error.");
+        for(long i = 0; i <= num_prev; i++)
+            vm_drop_location_group();
+        vm_push_status(VM_STATUS_ERROR);
+        return false;
+    }
+    return true;
+}
+
+// inst is the variable of a = a + e, returns true if its value was extended with the group on top
+static bool_t vm_add_inplace(instruction_t* inst, environment_t* env) {
+    // The value is only referenced by the variable and the stack, so nobody can observe the change
+    if(vm_status[vm_status_count-1] != 1 || vm_status[vm_status_count-2] != 1)
+        return false;
+    object_t* left = vm_values[vm_values_count-2];
+    object_t* right = vm_values[vm_values_count-1];
+    if(left->num_references == 2 && left->type == right->type
+        && (left->type == OBJECT_TYPE_LIST || (left->type == OBJECT_TYPE_STRING && left->data.string->num_references == 0))) {
+        object_t** loc = vm_variable(inst, env);
+        if(loc != NULL && *loc == left) {
+            if(left->type == OBJECT_TYPE_LIST)
+                list_append_all(left->data.list, right->data.list->data, right->data.list->size);
+            else
+                string_append(left->data.string, right->data.string);
+            vm_drop_group();
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns true if the top num_prev+1 checked groups were replaced by the result of and/or
+static bool_t vm_short_circuit(operation_type_t type, long num_prev) {
+    // Only scalar operands can decide the result, otherwise every operand is broadcast
+    bool_t decided = true;
+    for(long i = 0; decided && i <= num_prev; i++)
+        if(vm_status[vm_status_count-1-i] != 1)
+            decided = false;
+    if(decided)
+        decided = vm_values[vm_values_count-1]->data.boolean == (type == OPERATION_TYPE_OR);
+    if(decided) {
+        object_t* ret = vm_values[vm_values_count-1];
+        object_reference(ret);
+        for(long i = 0; i <= num_prev; i++)
+            vm_drop_group();
+        vm_push_value(ret);
+        vm_push_status(1);
+    }
+    return decided;
+}
+
+static void vm_concat(long num_groups) {
+    long num_ret = 0;
+    for(long i = 0; i < num_groups; i++)
+        num_ret += vm_status[--vm_status_count];
+    vm_push_status(num_ret);
+}
+
+static void vm_list() {
+    long status = vm_status[vm_status_count-1];
+    if(status != VM_STATUS_ERROR) {
+        list_t* list;
+        if(status == VM_STATUS_NULL) {
+            list = list_create_empty();
+        } else {
+            list = list_create_null(status);
+            for(long i = 0; i < status; i++)
+                list->data[i] = vm_values[vm_values_count-status+i];
+            vm_values_count -= status;
+        }
+        vm_status_count--;
+        vm_push_object(object_create_list(list));
+    }
+}
+
+static void vm_write(long done_status) {
+    long status = vm_status[vm_status_count-1];
+    if(status == VM_STATUS_NULL) {
+        error("Runtime error: Write NULL error.");
+        vm_status[vm_status_count-1] = VM_STATUS_ERROR;
+    } else if(status != VM_STATUS_ERROR) {
+        for(long i = 0; i < status; i++)
+            print_object(vm_values[vm_values_count-status+i]);
+        vm_drop_group();
+        vm_push_status(done_status);
+    }
+}
+
+static void vm_limit(bool_t local, environment_t* env) {
+    vm_push_limit(env->local_mode_limit);
+    environment_set_local_mode(env, local ? env->count-1 : 0);
+}
+
+// Consumes the condition group, returns false and leaves an error group if it is not a scalar
+static bool_t vm_cond(cond_msg_t msg, bool_t* taken) {
+    long status = vm_status[vm_status_count-1];
+    if(status == 1) {
+        object_t* cond = vm_values[--vm_values_count];
+        vm_status_count--;
+        *taken = is_true(cond);
+        object_dereference(cond);
+        return true;
+    } else {
+        if(status == VM_STATUS_NULL)
+            error(vm_cond_msg(msg, true));
+        else if(status != VM_STATUS_ERROR)
+            error(vm_cond_msg(msg, false));
+        vm_drop_group();
+        vm_push_status(VM_STATUS_ERROR);
+        return false;
+    }
+}
+
+static void vm_forin_next(size_t* pc, size_t jump) {
+    long pos_in = vm_status[vm_status_count-1];
+    long num_in = vm_status[vm_status_count-2];
+    long num_loc = vm_status[vm_status_count-3];
+
+    if(pos_in >= num_in) {
+        *pc = jump;
+    } else {
+        object_t*** vals_loc = vm_locations + vm_locations_count - num_loc;
+        object_t** vals_in = vm_values + vm_values_count - num_in;
+        for(long i = 0; i < num_loc && pos_in < num_in; i++) {
+            if(vals_loc[i] == OBJECT_LIST_OPENED) {
+                object_t** obj = vals_loc[i+1];
+                object_dereference(*obj);
+
+                list_t* list = list_create_null(num_in - pos_in);
+                for(long j = 0; j < num_in - pos_in; j++) {
+                    list->data[j] = vals_in[pos_in+j];
+                    object_reference(list->data[j]);
+                }
+                *obj = object_create_list(list);
+                object_reference(*obj);
+                pos_in = num_in;
+            } else {
+                object_dereference(*(vals_loc[i]));
+                *(vals_loc[i]) = vals_in[pos_in];
+                object_reference(*(vals_loc[i]));
+                pos_in++;
+            }
+        }
+        vm_status[vm_status_count-1] = pos_in;
+        (*pc)++;
+    }
+}
+
+// A call in tail position of a function body is not made but left to the caller of the body
+static object_t* vm_tail_func = NULL;
+static object_t** vm_tail_par = NULL;
+
+// Takes the function and parameter groups of a tail call, returns false if the call has to be made normally
+static bool_t vm_tail_call() {
+    long num_par = vm_status[vm_status_count-1];
+    long num_func = vm_status[vm_status_count-2];
+    if(num_func != 1 || num_par == VM_STATUS_ERROR)
+        return false;
+    long num_values = num_par >= 0 ? num_par : 0;
+    if(vm_values[vm_values_count-num_values-1]->type != OBJECT_TYPE_FUNCTION)
+        return false;
+
+    if(num_par >= 0) {
+        vm_tail_par = (object_t**)_alloc(sizeof(object_t*)*(num_par+1));
+        for(long i = 0; i < num_par; i++)
+            vm_tail_par[i] = vm_values[vm_values_count-num_par+i];
+        vm_tail_par[num_par] = NULL;
+        vm_values_count -= num_par;
+    } else
+        vm_tail_par = NULL;
+    vm_tail_func = vm_values[--vm_values_count];
+    vm_status_count -= 2;
+    return true;
+}
+
+static void vm_run(bytecode_t* code, environment_t* env, bool_t body) {
+    instruction_t* instructions = code->instructions;
+    size_t pc = 0;
+
+    for(;;) {
+        instruction_t* inst = instructions + pc;
+        switch(inst->opcode) {
+            case OPCODE_STATUS:
+                vm_push_status(inst->arg);
+                break;
+            case OPCODE_POP:
+                vm_drop_group();
+                break;
+            case OPCODE_JUMP:
+                pc = inst->jump;
+                continue;
+            case OPCODE_JUMP_ERROR:
+                if(vm_status[vm_status_count-1] == VM_STATUS_ERROR) {
+                    pc = inst->jump;
+                    continue;
+                }
+                vm_drop_group();
+                break;
+            case OPCODE_TREE_EXEC:
+                vm_push_status(operation_exec(inst->op, env) == RET_ERROR ? VM_STATUS_ERROR : 0);
+                break;
+            case OPCODE_TREE_RESULT: {
+                result_t res;
+                operation_result_into(inst->op, env, &res);
+                vm_push_result(&res);
+            } break;
+            case OPCODE_TREE_VAR:
+                vm_push_location_array(operation_var(inst->op, env));
+                break;
+            case OPCODE_NONE:
+                vm_push_object(object_create_none());
+                break;
+            case OPCODE_NUMBER:
+                vm_push_object(object_create_number(inst->op->data.num));
+                break;
+            case OPCODE_STRING:
+                vm_push_object(object_create_string(string_copy(inst->op->data.str)));
+                break;
+            case OPCODE_BOOL:
+                vm_push_object(object_create_boolean(inst->op->data.boolean));
+                break;
+            case OPCODE_CONSTANT:
+                vm_push_object(inst->op->constant);
+                break;
+            case OPCODE_FUNCTION:
+                vm_push_object(object_create_function(function_create(inst->op->data.operations[0], inst->op->data.operations[1])));
+                break;
+            case OPCODE_MACRO:
+                vm_push_object(object_create_macro(macro_create(inst->op->data.operations[0])));
+                break;
+            case OPCODE_VAR_EXEC:
+                vm_var_exec(inst, env);
+                break;
+            case OPCODE_VAR_RESULT:
+                vm_var_result(inst, env);
+                break;
+            case OPCODE_VAR_LOC:
+                vm_var_loc(inst, env);
+                break;
+            case OPCODE_ASSIGN:
+                vm_assign(inst->arg);
+                break;
+            case OPCODE_CHECK:
+                if(!vm_check(inst->op->type, inst->arg)) {
+                    pc = inst->jump;
+                    continue;
+                }
+                if(inst->deopts < VM_QUICKEN_MAX_DEOPTS && vm_quickens(inst->op->type) && vm_scalar_number(0))
+                    inst->opcode = OPCODE_CHECK_NUM;
+                break;
+            case OPCODE_CHECK_NUM:
+                if(!vm_scalar_number(0)) {
+                    inst->opcode = OPCODE_CHECK;
+                    inst->deopts++;
+                    continue;
+                }
+                break;
+            case OPCODE_ADD_INPLACE:
+                if(vm_add_inplace(inst, env)) {
+                    pc = inst->jump;
+                    continue;
+                }
+                break;
+            case OPCODE_SHORT_CIRCUIT:
+                if(vm_short_circuit(inst->op->type, inst->arg)) {
+                    pc = inst->jump;
+                    continue;
+                }
+                break;
+            case OPCODE_CHECK_LOC:
+                if(!vm_check_loc(inst->arg)) {
+                    pc = inst->jump;
+                    continue;
+                }
+                break;
+            case OPCODE_CONCAT:
+            case OPCODE_CONCAT_LOC:
+                vm_concat(inst->arg);
+                break;
+            case OPCODE_ARITHMETIC:
+                if(inst->arg == 2 && inst->deopts < VM_QUICKEN_MAX_DEOPTS && vm_quickens(inst->op->type) && vm_scalar_number(0) && vm_scalar_number(1)) {
+                    inst->opcode = OPCODE_ARITHMETIC_NUM;
+                    vm_arithmetic_num(inst->op->type);
+                } else
+                    vm_arithmetic(inst->op->type, inst->arg);
+                break;
+            case OPCODE_ARITHMETIC_NUM:
+                if(!vm_scalar_number(0) || !vm_scalar_number(1)) {
+                    inst->opcode = OPCODE_ARITHMETIC;
+                    inst->deopts++;
+                    continue;
+                }
+                vm_arithmetic_num(inst->op->type);
+                break;
+            case OPCODE_UNARY:
+                vm_unary(inst->op->type);
+                break;
+            case OPCODE_COMPARE:
+                if(inst->deopts < VM_QUICKEN_MAX_DEOPTS && vm_scalar_number(0) && vm_scalar_number(1)) {
+                    inst->opcode = OPCODE_COMPARE_NUM;
+                    vm_compare_num(inst->op->type);
+                } else
+                    vm_compare(inst->op->type);
+                break;
+            case OPCODE_COMPARE_NUM:
+                if(!vm_scalar_number(0) || !vm_scalar_number(1)) {
+                    inst->opcode = OPCODE_COMPARE;
+                    inst->deopts++;
+                    continue;
+                }
+                vm_compare_num(inst->op->type);
+                break;
+            case OPCODE_INDEX:
+                vm_index();
+                break;
+            case OPCODE_LIST:
+                vm_list();
+                break;
+            case OPCODE_LIST_OPEN:
+                vm_list_open();
+                break;
+            case OPCODE_LIST_OPEN_LOC:
+                vm_list_open_loc();
+                break;
+            case OPCODE_CALL:
+                vm_call(inst->arg, env);
+                break;
+            case OPCODE_TAIL_CALL:
+                if(body && vm_tail_call())
+                    return;
+                vm_call(true, env);
+                break;
+            case OPCODE_WRITE:
+                vm_write(inst->arg);
+                break;
+            case OPCODE_SCOPE_ENTER:
+                environment_add_scope(env);
+                break;
+            case OPCODE_SCOPE_EXIT:
+                environment_remove_scope(env);
+                break;
+            case OPCODE_LIMIT_LOCAL:
+            case OPCODE_LIMIT_GLOBAL:
+                vm_limit(inst->opcode == OPCODE_LIMIT_LOCAL, env);
+                break;
+            case OPCODE_LIMIT_RESTORE:
+                environment_set_local_mode(env, vm_limits[--vm_limits_count]);
+                break;
+            case OPCODE_COND: {
+                bool_t taken;
+                if(!vm_cond(inst->arg, &taken)) {
+                    pc = inst->jump;
+                    continue;
+                } else if(!taken) {
+                    pc = inst->jump_alt;
+                    continue;
+                }
+            } break;
+            case OPCODE_ACC_BEGIN:
+                vm_push_accumulator(list_create_empty());
+                break;
+            case OPCODE_ACC_APPEND: {
+                long status = vm_status[vm_status_count-1];
+                if(status == VM_STATUS_ERROR) {
+                    pc = inst->jump;
+                    continue;
+                } else if(status == VM_STATUS_NULL) {
+                    vm_status_count--;
+                    list_free(vm_accumulators[--vm_accumulators_count]);
+                    pc = inst->jump_alt;
+                    continue;
+                } else {
+                    list_append_all(vm_accumulators[vm_accumulators_count-1], vm_values + vm_values_count - status, status);
+                    vm_drop_group();
+                }
+            } break;
+            case OPCODE_ACC_END: {
+                list_t* list = vm_accumulators[--vm_accumulators_count];
+                for(long i = 0; i < list->size; i++)
+                    vm_push_value(list->data[i]);
+                vm_push_status(list->size);
+                _free(list->data);
+                _free(list);
+            } break;
+            case OPCODE_ACC_DROP:
+                list_free(vm_accumulators[--vm_accumulators_count]);
+                break;
+            case OPCODE_FORIN_INIT: {
+                long num_in = vm_status[vm_status_count-1];
+                long num_loc = vm_status[vm_status_count-2];
+                if(num_loc < 0 || num_in < 0) {
+                    if(num_loc == VM_STATUS_NULL || num_in == VM_STATUS_NULL)
+                        error("Runtime error: For-in NULL error.");
+                    vm_drop_group();
+                    vm_drop_location_group();
+                    vm_push_status(VM_STATUS_ERROR);
+                    pc = inst->jump;
+                    continue;
+                }
+                // The number of iterations is known, so the comprehension result can be presized
+                if(inst->arg != 0 && num_loc > 0)
+                    list_reserve(vm_accumulators[vm_accumulators_count-1], (num_in + num_loc - 1) / num_loc);
+                vm_push_status(0);
+            } break;
+            case OPCODE_FORIN_NEXT:
+                vm_forin_next(&pc, inst->jump);
+                continue;
+            case OPCODE_FORIN_CHECK:
+                if(vm_status[vm_status_count-1] == VM_STATUS_ERROR) {
+                    vm_status_count--;
+                    vm_forin_drop_state();
+                    vm_push_status(VM_STATUS_ERROR);
+                    pc = inst->jump_alt;
+                } else {
+                    vm_drop_group();
+                    pc = inst->jump;
+                }
+                continue;
+            case OPCODE_FORIN_END:
+                vm_forin_drop_state();
+                break;
+            case OPCODE_FORIN_DROP:
+                vm_status_count--;
+                vm_forin_drop_state();
+                vm_push_status(VM_STATUS_ERROR);
+                break;
+            case OPCODE_JIT_LOOP:
+                if(jit_run_loop(inst->op, env)) {
+                    vm_push_status(0);
+                    pc = inst->jump;
+                    continue;
+                }
+                break;
+            case OPCODE_RETURN:
+                return;
+        }
+        pc++;
+    }
+}
+
+// The closure engine turns an operation tree into a tree of nodes that call the routines of their
+// children directly. Every routine leaves exactly one group on the vm stacks, like a compiled
+// instruction sequence, so constructs without a routine of their own run as bytecode.
+typedef struct closure_s closure_t;
+typedef void (*closure_routine_t)(closure_t* closure, environment_t* env);
+
+struct closure_s {
+    closure_routine_t routine;
+    instruction_t inst;         // operation, argument and caches of the instruction the node stands for
+    size_t num_children;
+    closure_t** children;
+};
+
+#define VM_CLOSURE_RUN(C, ENV) ((C)->routine((C), (ENV)))
+
+static vm_engine_t vm_engine = VM_ENGINE_BYTECODE;
+
+void vm_set_engine(vm_engine_t engine) {
+    vm_engine = engine;
+}
+
+static closure_t* vm_closure_create(closure_routine_t routine, operation_t* op, long arg, size_t num_children) {
+    closure_t* ret = (closure_t*)_alloc(sizeof(closure_t));
+    ret->routine = routine;
+    ret->inst.opcode = OPCODE_RETURN;
+    ret->inst.arg = arg;
+    ret->inst.jump = 0;
+    ret->inst.jump_alt = 0;
+    ret->inst.op = op;
+    ret->inst.cache_env = NULL;
+    ret->inst.cache_generation = 0;
+    ret->inst.cache_limit = 0;
+    ret->inst.cache_loc = NULL;
+    ret->inst.deopts = 0;
+    ret->num_children = num_children;
+    ret->children = num_children > 0 ? (closure_t**)_alloc(sizeof(closure_t*)*num_children) : NULL;
+    return ret;
+}
+
+void vm_closure_free(closure_t* closure) {
+    if(closure != NULL) {
+        for(size_t i = 0; i < closure->num_children; i++)
+            vm_closure_free(closure->children[i]);
+        if(closure->children != NULL)
+            _free(closure->children);
+        _free(closure);
+    }
+}
+
+static void vm_closure_status(closure_t* c, environment_t* env) {
+    vm_push_status(c->inst.arg);
+}
+
+static void vm_closure_none(closure_t* c, environment_t* env) {
+    vm_push_object(object_create_none());
+}
+
+static void vm_closure_number(closure_t* c, environment_t* env) {
+    vm_push_object(object_create_number(c->inst.op->data.num));
+}
+
+static void vm_closure_string(closure_t* c, environment_t* env) {
+    vm_push_object(object_create_string(string_copy(c->inst.op->data.str)));
+}
+
+static void vm_closure_bool(closure_t* c, environment_t* env) {
+    vm_push_object(object_create_boolean(c->inst.op->data.boolean));
+}
+
+static void vm_closure_constant(closure_t* c, environment_t* env) {
+    vm_push_object(c->inst.op->constant);
+}
+
+static void vm_closure_function(closure_t* c, environment_t* env) {
+    vm_push_object(object_create_function(function_create(c->inst.op->data.operations[0], c->inst.op->data.operations[1])));
+}
+
+static void vm_closure_macro(closure_t* c, environment_t* env) {
+    vm_push_object(object_create_macro(macro_create(c->inst.op->data.operations[0])));
+}
+
+static void vm_closure_var_exec(closure_t* c, environment_t* env) {
+    vm_var_exec(&c->inst, env);
+}
+
+static void vm_closure_var_result(closure_t* c, environment_t* env) {
+    vm_var_result(&c->inst, env);
+}
+
+static void vm_closure_var_loc(closure_t* c, environment_t* env) {
+    vm_var_loc(&c->inst, env);
+}
+
+static void vm_closure_tree_var(closure_t* c, environment_t* env) {
+    vm_push_location_array(operation_var(c->inst.op, env));
+}
+
+static void vm_closure_code_exec(closure_t* c, environment_t* env) {
+    if(c->inst.op->exec_code == NULL)
+        c->inst.op->exec_code = bytecode_compile_exec(c->inst.op);
+    vm_run(c->inst.op->exec_code, env, false);
+}
+
+static void vm_closure_code_result(closure_t* c, environment_t* env) {
+    if(c->inst.op->result_code == NULL)
+        c->inst.op->result_code = bytecode_compile_result(c->inst.op);
+    vm_run(c->inst.op->result_code, env, false);
+}
+
+static void vm_closure_assign(closure_t* c, environment_t* env) {
+    VM_CLOSURE_RUN(c->children[0], env);
+    VM_CLOSURE_RUN(c->children[1], env);
+    vm_assign(c->inst.arg);
+}
+
+static void vm_closure_two_operands(operation_type_t type) {
+    if(vm_quickens(type) && vm_scalar_number(0) && vm_scalar_number(1))
+        vm_arithmetic_num(type);
+    else
+        vm_arithmetic(type, 2);
+}
+
+// The children are the value of a, e and the location of a
+static void vm_closure_self_add(closure_t* c, environment_t* env) {
+    operation_type_t type = c->inst.op->type;
+    VM_CLOSURE_RUN(c->children[0], env);
+    if(vm_check(type, 0)) {
+        VM_CLOSURE_RUN(c->children[1], env);
+        if(vm_check(type, 1) && !vm_add_inplace(&c->children[0]->inst, env))
+            vm_closure_two_operands(type);
+    }
+    VM_CLOSURE_RUN(c->children[2], env);
+    vm_assign(c->inst.arg);
+}
+
+static void vm_closure_proc(closure_t* c, environment_t* env) {
+    for(size_t i = 0; i+1 < c->num_children; i++) {
+        VM_CLOSURE_RUN(c->children[i], env);
+        if(vm_status[vm_status_count-1] == VM_STATUS_ERROR)
+            return;
+        vm_drop_group();
+    }
+    VM_CLOSURE_RUN(c->children[c->num_children-1], env);
+}
+
+// Evaluates and checks the operands from operand i on and combines them, operand i is already on the stack if evaluated is set
+static void vm_closure_combine_from(closure_t* c, environment_t* env, size_t i, bool_t evaluated) {
+    operation_type_t type = c->inst.op->type;
+    for(; i < c->num_children; i++) {
+        if(!evaluated)
+            VM_CLOSURE_RUN(c->children[i], env);
+        evaluated = false;
+        if(!vm_check(type, i))
+            return;
+        if(i+1 < c->num_children && (type == OPERATION_TYPE_AND || type == OPERATION_TYPE_OR) && vm_short_circuit(type, i))
+            return;
+    }
+    if(type == OPERATION_TYPE_O_LIST)
+        vm_concat(c->num_children);
+    else if(c->num_children == 2)
+        vm_closure_two_operands(type);
+    else
+        vm_arithmetic(type, c->num_children);
+}
+
+static void vm_closure_combine(closure_t* c, environment_t* env) {
+    vm_closure_combine_from(c, env, 0, false);
+}
+
+// Binary + - * / where both operands are scalar numbers skip the generic checks
+static void vm_closure_arithmetic_num(closure_t* c, environment_t* env) {
+    VM_CLOSURE_RUN(c->children[0], env);
+    if(!vm_scalar_number(0)) {
+        vm_closure_combine_from(c, env, 0, true);
+        return;
+    }
+    VM_CLOSURE_RUN(c->children[1], env);
+    if(!vm_scalar_number(0)) {
+        vm_closure_combine_from(c, env, 1, true);
+        return;
+    }
+    vm_arithmetic_num(c->inst.op->type);
+}
+
+static void vm_closure_unary(closure_t* c, environment_t* env) {
+    VM_CLOSURE_RUN(c->children[0], env);
+    vm_unary(c->inst.op->type);
+}
+
+static void vm_closure_compare(closure_t* c, environment_t* env) {
+    VM_CLOSURE_RUN(c->children[0], env);
+    VM_CLOSURE_RUN(c->children[1], env);
+    if(vm_scalar_number(0) && vm_scalar_number(1))
+        vm_compare_num(c->inst.op->type);
+    else
+        vm_compare(c->inst.op->type);
+}
+
+static void vm_closure_index(closure_t* c, environment_t* env) {
+    VM_CLOSURE_RUN(c->children[0], env);
+    VM_CLOSURE_RUN(c->children[1], env);
+    vm_index();
+}
+
+static void vm_closure_list(closure_t* c, environment_t* env) {
+    VM_CLOSURE_RUN(c->children[0], env);
+    vm_list();
+}
+
+static void vm_closure_list_open(closure_t* c, environment_t* env) {
+    VM_CLOSURE_RUN(c->children[0], env);
+    vm_list_open();
+}
+
+static void vm_closure_call(closure_t* c, environment_t* env) {
+    VM_CLOSURE_RUN(c->children[0], env);
+    VM_CLOSURE_RUN(c->children[1], env);
+    vm_call(c->inst.arg, env);
+}
+
+// A call in tail position of a function body, which is left to the caller of the body if possible
+static void vm_closure_tail_call(closure_t* c, environment_t* env) {
+    VM_CLOSURE_RUN(c->children[0], env);
+    VM_CLOSURE_RUN(c->children[1], env);
+    if(!vm_tail_call())
+        vm_call(true, env);
+}
+
+static void vm_closure_write(closure_t* c, environment_t* env) {
+    VM_CLOSURE_RUN(c->children[0], env);
+    vm_write(c->inst.arg);
+}
+
+static void vm_closure_scope(closure_t* c, environment_t* env) {
+    environment_add_scope(env);
+    VM_CLOSURE_RUN(c->children[0], env);
+    environment_remove_scope(env);
+}
+
+static void vm_closure_limit(closure_t* c, environment_t* env) {
+    vm_limit(c->inst.op->type == OPERATION_TYPE_LOCAL, env);
+    VM_CLOSURE_RUN(c->children[0], env);
+    environment_set_local_mode(env, vm_limits[--vm_limits_count]);
+}
+
+// For if and if-else, arg is the status left if no branch is taken
+static void vm_closure_if(closure_t* c, environment_t* env) {
+    bool_t taken;
+    VM_CLOSURE_RUN(c->children[0], env);
+    if(!vm_cond(c->inst.op->type == OPERATION_TYPE_IF ? COND_MSG_IF : COND_MSG_IFELSE, &taken))
+        return;
+    if(taken)
+        VM_CLOSURE_RUN(c->children[1], env);
+    else if(c->num_children > 2)
+        VM_CLOSURE_RUN(c->children[2], env);
+    else
+        vm_push_status(c->inst.arg);
+}
+
+// The children are the condition, the body and for for-loops the step
+static void vm_closure_loop_exec(closure_t* c, environment_t* env) {
+    cond_msg_t msg = c->num_children > 2 ? COND_MSG_FOR_LOWER : COND_MSG_WHILE;
+    if(jit_run_loop(c->inst.op, env)) {
+        vm_push_status(0);
+        return;
+    }
+    for(;;) {
+        bool_t taken;
+        VM_CLOSURE_RUN(c->children[0], env);
+        if(!vm_cond(msg, &taken))
+            return;
+        if(!taken) {
+            vm_push_status(0);
+            return;
+        }
+        for(size_t i = 1; i < c->num_children; i++) {
+            VM_CLOSURE_RUN(c->children[i], env);
+            if(vm_status[vm_status_count-1] == VM_STATUS_ERROR)
+                return;
+            vm_drop_group();
+        }
+    }
+}
+
+static void vm_closure_for_exec(closure_t* c, environment_t* env) {
+    VM_CLOSURE_RUN(c->children[0], env);
+    vm_drop_group();
+    vm_closure_loop_exec(c->children[1], env);
+}
+
+static void vm_closure_concat_loc(closure_t* c, environment_t* env) {
+    for(size_t i = 0; i < c->num_children; i++) {
+        VM_CLOSURE_RUN(c->children[i], env);
+        if(!vm_check_loc(i))
+            return;
+    }
+    vm_concat(c->num_children);
+}
+
+static void vm_closure_list_open_loc(closure_t* c, environment_t* env) {
+    VM_CLOSURE_RUN(c->children[0], env);
+    vm_list_open_loc();
+}
+
+static closure_t* vm_closure_compile_exec(operation_t* op);
+static closure_t* vm_closure_compile_result(operation_t* op);
+static closure_t* vm_closure_compile_body(operation_t* op);
+
+static closure_t* vm_closure_compile_var(operation_t* op) {
+    closure_t* ret;
+    if(op == NULL)
+        return vm_closure_create(vm_closure_status, NULL, VM_STATUS_NULL, 0);
+    switch(op->type) {
+        case OPERATION_TYPE_VAR:
+            ret = vm_closure_create(vm_closure_var_loc, op, 0, 0);
+            break;
+        case OPERATION_TYPE_O_LIST: {
+            size_t num_op = bytecode_count_operations(op);
+            ret = vm_closure_create(vm_closure_concat_loc, op, 0, num_op);
+            for(size_t i = 0; i < num_op; i++)
+                ret->children[i] = vm_closure_compile_var(op->data.operations[i]);
+        } break;
+        case OPERATION_TYPE_LIST_OPEN:
+            ret = vm_closure_create(vm_closure_list_open_loc, op, 0, 1);
+            ret->children[0] = vm_closure_compile_var(op->data.operations[0]);
+            break;
+        default:
+            ret = vm_closure_create(vm_closure_tree_var, op, 0, 0);
+            break;
+    }
+    return ret;
+}
+
+static closure_t* vm_closure_compile_assign(operation_t* op, long result) {
+    closure_t* ret;
+    if(bytecode_is_self_add(op)) {
+        operation_t* add = op->data.operations[1];
+        ret = vm_closure_create(vm_closure_self_add, add, result, 3);
+        ret->children[0] = vm_closure_compile_result(add->data.operations[0]);
+        ret->children[1] = vm_closure_compile_result(add->data.operations[1]);
+        ret->children[2] = vm_closure_compile_var(op->data.operations[0]);
+    } else {
+        ret = vm_closure_create(vm_closure_assign, op, result, 2);
+        ret->children[0] = vm_closure_compile_result(op->data.operations[1]);
+        ret->children[1] = vm_closure_compile_var(op->data.operations[0]);
+    }
+    return ret;
+}
+
+// compile_last compiles the operation whose groups are left on the stack
+static closure_t* vm_closure_compile_proc(operation_t* op, closure_t* (*compile_last)(operation_t*)) {
+    size_t num_op = bytecode_count_operations(op);
+    closure_t* ret = vm_closure_create(vm_closure_proc, op, 0, num_op);
+    for(size_t i = 0; i < num_op; i++)
+        ret->children[i] = i+1 == num_op ? compile_last(op->data.operations[i]) : vm_closure_compile_exec(op->data.operations[i]);
+    return ret;
+}
+
+// compile_branch compiles the branches, the result is NULL if no branch is taken unless they are compiled for exec
+static closure_t* vm_closure_compile_if(operation_t* op, closure_t* (*compile_branch)(operation_t*)) {
+    size_t num_op = op->type == OPERATION_TYPE_IFELSE ? 3 : 2;
+    closure_t* ret = vm_closure_create(vm_closure_if, op, compile_branch != vm_closure_compile_exec ? VM_STATUS_NULL : 0, num_op);
+    ret->children[0] = vm_closure_compile_result(op->data.operations[0]);
+    for(size_t i = 1; i < num_op; i++)
+        ret->children[i] = compile_branch(op->data.operations[i]);
+    return ret;
+}
+
+static closure_t* vm_closure_compile_unary(closure_routine_t routine, operation_t* op, long arg, bool_t result) {
+    closure_t* ret = vm_closure_create(routine, op, arg, 1);
+    ret->children[0] = result ? vm_closure_compile_result(op->data.operations[0]) : vm_closure_compile_exec(op->data.operations[0]);
+    return ret;
+}
+
+static closure_t* vm_closure_compile_binary(closure_routine_t routine, operation_t* op, long arg) {
+    closure_t* ret = vm_closure_create(routine, op, arg, 2);
+    ret->children[0] = vm_closure_compile_result(op->data.operations[0]);
+    ret->children[1] = vm_closure_compile_result(op->data.operations[1]);
+    return ret;
+}
+
+static closure_t* vm_closure_compile_exec(operation_t* op) {
+    closure_t* ret;
+    if(op == NULL)
+        return vm_closure_create(vm_closure_status, NULL, 0, 0);
+    switch(op->type) {
+        case OPERATION_TYPE_NOOP:
+        case OPERATION_TYPE_NOOP_BRAC:
+        case OPERATION_TYPE_NOOP_EMP_REC:
+        case OPERATION_TYPE_NOOP_O_LIST_DEADEND:
+        case OPERATION_TYPE_NOOP_PROC_DEADEND:
+        case OPERATION_TYPE_NOOP_PLUS:
+        case OPERATION_TYPE_NOOP_EMP_CUR:
+        case OPERATION_TYPE_NONE:
+        case OPERATION_TYPE_NUM:
+        case OPERATION_TYPE_STR:
+        case OPERATION_TYPE_BOOL:
+        case OPERATION_TYPE_FUNCTION:
+        case OPERATION_TYPE_MACRO:
+            ret = vm_closure_create(vm_closure_status, op, 0, 0);
+            break;
+        case OPERATION_TYPE_VAR:
+            ret = vm_closure_create(vm_closure_var_exec, op, 0, 0);
+            break;
+        case OPERATION_TYPE_ASSIGN:
+            ret = vm_closure_compile_assign(op, 0);
+            break;
+        case OPERATION_TYPE_PROC:
+        case OPERATION_TYPE_PROC_IMP:
+            ret = vm_closure_compile_proc(op, vm_closure_compile_exec);
+            break;
+        case OPERATION_TYPE_EXEC:
+            ret = vm_closure_compile_binary(vm_closure_call, op, 0);
+            break;
+        case OPERATION_TYPE_WRITE:
+            ret = vm_closure_create(vm_closure_write, op, 0, 1);
+            ret->children[0] = vm_closure_compile_result(op->data.operations[0]);
+            break;
+        case OPERATION_TYPE_SCOPE:
+            ret = vm_closure_compile_unary(vm_closure_scope, op, 0, false);
+            break;
+        case OPERATION_TYPE_LOCAL:
+        case OPERATION_TYPE_GLOBAL:
+            ret = vm_closure_compile_unary(vm_closure_limit, op, 0, false);
+            break;
+        case OPERATION_TYPE_IF:
+        case OPERATION_TYPE_IFELSE:
+            ret = vm_closure_compile_if(op, vm_closure_compile_exec);
+            break;
+        case OPERATION_TYPE_WHILE:
+            ret = vm_closure_create(vm_closure_loop_exec, op, 0, 2);
+            ret->children[0] = vm_closure_compile_result(op->data.operations[0]);
+            ret->children[1] = vm_closure_compile_exec(op->data.operations[1]);
+            break;
+        case OPERATION_TYPE_FOR: {
+            closure_t* loop = vm_closure_create(vm_closure_loop_exec, op, 0, 3);
+            loop->children[0] = vm_closure_compile_result(op->data.operations[1]);
+            loop->children[1] = vm_closure_compile_exec(op->data.operations[3]);
+            loop->children[2] = vm_closure_compile_exec(op->data.operations[2]);
+            ret = vm_closure_create(vm_closure_for_exec, op, 0, 2);
+            ret->children[0] = vm_closure_compile_exec(op->data.operations[0]);
+            ret->children[1] = loop;
+        } break;
+        default:
+            ret = vm_closure_create(vm_closure_code_exec, op, 0, 0);
+            break;
+    }
+    return ret;
+}
+
+static closure_t* vm_closure_compile_result(operation_t* op) {
+    closure_t* ret;
+    if(op == NULL)
+        return vm_closure_create(vm_closure_status, NULL, VM_STATUS_NULL, 0);
+    switch(op->type) {
+        case OPERATION_TYPE_NOOP:
+        case OPERATION_TYPE_NOOP_BRAC:
+        case OPERATION_TYPE_NOOP_EMP_REC:
+        case OPERATION_TYPE_NOOP_O_LIST_DEADEND:
+        case OPERATION_TYPE_NOOP_PROC_DEADEND:
+        case OPERATION_TYPE_NOOP_PLUS:
+        case OPERATION_TYPE_NOOP_EMP_CUR:
+            ret = vm_closure_create(vm_closure_status, op, VM_STATUS_NULL, 0);
+            break;
+        case OPERATION_TYPE_NONE:
+            ret = vm_closure_create(vm_closure_none, op, 0, 0);
+            break;
+        case OPERATION_TYPE_NUM:
+            ret = vm_closure_create(op->constant != NULL ? vm_closure_constant : vm_closure_number, op, 0, 0);
+            break;
+        case OPERATION_TYPE_STR:
+            ret = vm_closure_create(op->constant != NULL ? vm_closure_constant : vm_closure_string, op, 0, 0);
+            break;
+        case OPERATION_TYPE_BOOL:
+            ret = vm_closure_create(vm_closure_bool, op, 0, 0);
+            break;
+        case OPERATION_TYPE_FUNCTION:
+            ret = vm_closure_create(vm_closure_function, op, 0, 0);
+            break;
+        case OPERATION_TYPE_MACRO:
+            ret = vm_closure_create(vm_closure_macro, op, 0, 0);
+            break;
+        case OPERATION_TYPE_VAR:
+            ret = vm_closure_create(vm_closure_var_result, op, 0, 0);
+            break;
+        case OPERATION_TYPE_ASSIGN:
+            ret = vm_closure_compile_assign(op, 1);
+            break;
+        case OPERATION_TYPE_PROC:
+        case OPERATION_TYPE_PROC_IMP:
+            ret = vm_closure_compile_proc(op, vm_closure_compile_result);
+            break;
+        case OPERATION_TYPE_O_LIST:
+        case OPERATION_TYPE_ADD:
+        case OPERATION_TYPE_SUB:
+        case OPERATION_TYPE_MUL:
+        case OPERATION_TYPE_DIV:
+        case OPERATION_TYPE_MOD:
+        case OPERATION_TYPE_POW:
+        case OPERATION_TYPE_AND:
+        case OPERATION_TYPE_OR:
+        case OPERATION_TYPE_XOR: {
+            size_t num_op = bytecode_count_operations(op);
+            ret = vm_closure_create(num_op == 2 && vm_quickens(op->type) ? vm_closure_arithmetic_num : vm_closure_combine, op, 0, num_op);
+            for(size_t i = 0; i < num_op; i++)
+                ret->children[i] = vm_closure_compile_result(op->data.operations[i]);
+        } break;
+        case OPERATION_TYPE_NEG:
+        case OPERATION_TYPE_NOT:
+            ret = vm_closure_compile_unary(vm_closure_unary, op, 0, true);
+            break;
+        case OPERATION_TYPE_EQU:
+        case OPERATION_TYPE_GEQ:
+        case OPERATION_TYPE_LEQ:
+        case OPERATION_TYPE_GTR:
+        case OPERATION_TYPE_LES:
+            ret = vm_closure_compile_binary(vm_closure_compare, op, 0);
+            break;
+        case OPERATION_TYPE_INDEX:
+            ret = vm_closure_compile_binary(vm_closure_index, op, 0);
+            break;
+        case OPERATION_TYPE_LIST:
+            ret = vm_closure_compile_unary(vm_closure_list, op, 0, true);
+            break;
+        case OPERATION_TYPE_LIST_OPEN:
+            ret = vm_closure_compile_unary(vm_closure_list_open, op, 0, true);
+            break;
+        case OPERATION_TYPE_EXEC:
+            ret = vm_closure_compile_binary(vm_closure_call, op, 1);
+            break;
+        case OPERATION_TYPE_WRITE:
+            ret = vm_closure_compile_unary(vm_closure_write, op, VM_STATUS_NULL, true);
+            break;
+        case OPERATION_TYPE_SCOPE:
+            ret = vm_closure_compile_unary(vm_closure_scope, op, 0, true);
+            break;
+        case OPERATION_TYPE_LOCAL:
+        case OPERATION_TYPE_GLOBAL:
+            ret = vm_closure_compile_unary(vm_closure_limit, op, 0, true);
+            break;
+        case OPERATION_TYPE_IF:
+        case OPERATION_TYPE_IFELSE:
+            ret = vm_closure_compile_if(op, vm_closure_compile_result);
+            break;
+        default:
+            ret = vm_closure_create(vm_closure_code_result, op, 0, 0);
+            break;
+    }
+    return ret;
+}
+
+// Calls in tail position become tail calls, everything else is compiled as for the result
+static closure_t* vm_closure_compile_body(operation_t* op) {
+    closure_t* ret;
+    if(op == NULL)
+        return vm_closure_compile_result(op);
+    switch(op->type) {
+        case OPERATION_TYPE_PROC:
+        case OPERATION_TYPE_PROC_IMP:
+            ret = vm_closure_compile_proc(op, vm_closure_compile_body);
+            break;
+        case OPERATION_TYPE_IF:
+        case OPERATION_TYPE_IFELSE:
+            ret = vm_closure_compile_if(op, vm_closure_compile_body);
+            break;
+        case OPERATION_TYPE_EXEC:
+            ret = vm_closure_compile_binary(vm_closure_tail_call, op, 1);
+            break;
+        default:
+            ret = vm_closure_compile_result(op);
+            break;
+    }
+    return ret;
+}
+
+void* vm_exec(operation_t* op, environment_t* env) {
+    void* ret = NULL;
+
+    if(vm_engine == VM_ENGINE_TREE) {
+        ret = operation_exec(op, env);
+    } else if(check_for_stackoverflow()) {
+        error("Runtime error: Stack overflow.");
+        ret = RET_ERROR;
+    } else if(op != NULL) {
+        if(vm_engine == VM_ENGINE_CLOSURE) {
+            if(op->exec_closure == NULL)
+                op->exec_closure = vm_closure_compile_exec(op);
+            VM_CLOSURE_RUN(op->exec_closure, env);
+        } else {
+            if(op->exec_code == NULL)
+                op->exec_code = bytecode_compile_exec(op);
+            vm_run(op->exec_code, env, false);
+        }
+        if(vm_status[vm_status_count-1] == VM_STATUS_ERROR)
+            ret = RET_ERROR;
+        vm_drop_group();
+    }
+
+    return ret;
+}
+
+static object_t** vm_pop_result() {
+    object_t** ret = NULL;
+    long status = vm_status[--vm_status_count];
+    if(status == VM_STATUS_ERROR) {
+        ret = RET_ERROR;
+    } else if(status != VM_STATUS_NULL) {
+        ret = (object_t**)_alloc(sizeof(object_t*)*(status+1));
+        vm_values_count -= status;
+        for(long i = 0; i < status; i++)
+            ret[i] = vm_values[vm_values_count+i];
+        ret[status] = NULL;
+    }
+    return ret;
+}
+
+object_t** vm_result(operation_t* op, environment_t* env) {
+    object_t** ret = NULL;
+
+    if(vm_engine == VM_ENGINE_TREE) {
+        ret = operation_result(op, env);
+    } else if(check_for_stackoverflow()) {
+        error("Runtime error: Stack overflow.");
+        ret = RET_ERROR;
+    } else if(op != NULL) {
+        if(vm_engine == VM_ENGINE_CLOSURE) {
+            if(op->result_closure == NULL)
+                op->result_closure = vm_closure_compile_result(op);
+            VM_CLOSURE_RUN(op->result_closure, env);
+        } else {
+            if(op->result_code == NULL)
+                op->result_code = bytecode_compile_result(op);
+            vm_run(op->result_code, env, false);
+        }
+        ret = vm_pop_result();
+    }
+
+    return ret;
+}
+
+object_t** vm_result_body(operation_t* op, environment_t* env, object_t** tail_func, object_t*** tail_par) {
+    object_t** ret = NULL;
+
+    *tail_func = NULL;
+    *tail_par = NULL;
+    if(vm_engine == VM_ENGINE_TREE) {
+        ret = operation_result_body(op, env, tail_func, tail_par);
+    } else if(op == NULL) {
+        ret = vm_result(op, env);
+    } else if(check_for_stackoverflow()) {
+        error("Runtime error: Stack overflow.");
+        ret = RET_ERROR;
+    } else {
+        if(vm_engine == VM_ENGINE_CLOSURE) {
+            if(op->body_closure == NULL)
+                op->body_closure = vm_closure_compile_body(op);
+            VM_CLOSURE_RUN(op->body_closure, env);
+        } else {
+            if(op->result_code == NULL)
+                op->result_code = bytecode_compile_result(op);
+            vm_run(op->result_code, env, true);
+        }
+        if(vm_tail_func != NULL) {
+            *tail_func = vm_tail_func;
+            *tail_par = vm_tail_par;
+            vm_tail_func = NULL;
+            vm_tail_par = NULL;
+        } else
+            ret = vm_pop_result();
+    }
+
+    return ret;
+}
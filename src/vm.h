@@ -0,0 +1,25 @@
+// Copyright (c) 2018-2019 Roland Bernard
+
+#ifndef __VM_H__
+#define __VM_H__
+
+#include "./types.h"
+#include "./operation.h"
+#include "./environment.h"
+
+typedef enum vm_engine_e {
+    VM_ENGINE_BYTECODE,     // compile to bytecode and run it in the vm
+    VM_ENGINE_CLOSURE,      // compile to a tree of closures calling each other directly
+    VM_ENGINE_TREE,         // walk the operation tree
+} vm_engine_t;
+
+struct closure_s;
+
+void vm_set_engine(vm_engine_t engine);
+void vm_closure_free(struct closure_s* closure);
+void* vm_exec(operation_t* op, environment_t* env);
+object_t** vm_result(operation_t* op, environment_t* env);
+// Runs a function body, a call in tail position is not made but returned in tail_func and tail_par, which the caller owns
+object_t** vm_result_body(operation_t* op, environment_t* env, object_t** tail_func, object_t*** tail_par);
+
+#endif